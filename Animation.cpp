@@ -15,50 +15,201 @@
  ***************************************************************************************************/
 
 #include "Animation.h"
+#include "Mode.h"
 
 /******************************************************************************
  *                        火焰动画 (Flame Animation)
  ******************************************************************************/
 
+// ---- 火焰调色板 (编译期生成的 256 项查找表) ----
+
+/**
+ * @brief 调色板渐变节点：热度 pos 处的颜色为 (r, g, b)。
+ * @details 相邻两个节点之间按 Arduino map() 的整数公式线性插值，
+ *          因此经典火焰调色板与原先逐像素 map() 计算的结果完全一致。
+ */
+struct PaletteStop {
+    uint8_t pos;
+    uint8_t r, g, b;
+};
+
+/**
+ * @brief 256 项 GRB 颜色表。
+ */
+struct PaletteTable {
+    uint32_t color[256];
+};
+
+/**
+ * @brief 与 map() 相同的整数线性插值 (constexpr 版本)。
+ */
+constexpr long palette_map(long x, long in_min, long in_max, long out_min, long out_max) {
+    return (in_max == in_min) ? out_min
+                              : (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+/**
+ * @brief 根据渐变节点生成调色板 (编译期执行)。热度 0 固定为黑色。
+ */
+template <size_t N>
+constexpr PaletteTable make_palette(const PaletteStop (&stops)[N]) {
+    PaletteTable table = {};
+    for (int t = 1; t < 256; t++) {
+        size_t i = 0;
+        while (i + 2 < N && t > stops[i + 1].pos) i++;
+        const PaletteStop& lo = stops[i];
+        const PaletteStop& hi = stops[i + 1];
+        uint32_t r = (uint32_t)palette_map(t, lo.pos, hi.pos, lo.r, hi.r);
+        uint32_t g = (uint32_t)palette_map(t, lo.pos, hi.pos, lo.g, hi.g);
+        uint32_t b = (uint32_t)palette_map(t, lo.pos, hi.pos, lo.b, hi.b);
+        table.color[t] = (g << 16) | (r << 8) | b;
+    }
+    return table;
+}
+
+// 经典火焰: 黑(0,0,0) -> 深红(180,0,0) -> 亮橙(255,100,0) -> 亮黄(255,255,0)
+constexpr PaletteStop classic_stops[] = {
+    {0, 0, 0, 0}, {85, 180, 0, 0}, {86, 180, 0, 0}, {170, 255, 100, 0}, {171, 255, 100, 0}, {255, 255, 255, 0}
+};
+// 燃气蓝焰
+constexpr PaletteStop blue_gas_stops[] = {
+    {0, 0, 0, 0}, {80, 0, 0, 160}, {170, 0, 120, 255}, {255, 200, 255, 255}
+};
+// 毒气绿焰
+constexpr PaletteStop toxic_green_stops[] = {
+    {0, 0, 0, 0}, {80, 0, 90, 0}, {170, 60, 255, 0}, {255, 220, 255, 120}
+};
+// 魔法紫焰
+constexpr PaletteStop purple_stops[] = {
+    {0, 0, 0, 0}, {80, 90, 0, 140}, {170, 255, 40, 200}, {255, 255, 220, 255}
+};
+
+static const PaletteTable palette_classic PROGMEM     = make_palette(classic_stops);
+static const PaletteTable palette_blue_gas PROGMEM    = make_palette(blue_gas_stops);
+static const PaletteTable palette_toxic_green PROGMEM = make_palette(toxic_green_stops);
+static const PaletteTable palette_purple PROGMEM      = make_palette(purple_stops);
+
+// 按 FlamePalette 编号排列
+static const uint32_t* const flame_palettes[(int)FlamePalette::COUNT] = {
+    palette_classic.color,
+    palette_blue_gas.color,
+    palette_toxic_green.color,
+    palette_purple.color
+};
+
+static FlamePalette flame_palette_id = FlamePalette::CLASSIC;
+
+// 火焰动画的工作状态 (热度图等)，进入模式时从模式内存池申请，字段见 FlameState
+static FlameState* flame;
+
+#if FLAME_PALETTE_IN_RAM
+// 当前调色板在 RAM 中的副本属于火焰的模式状态，切换模式后重新载入
+#define FLAME_PALETTE_LOOKUP(t) (flame->palette_ram[(t)])
+#else
+// 当前调色板 (指向 Flash 中的表，切换时只交换指针)
+static const uint32_t* flame_palette = palette_classic.color;
+#define FLAME_PALETTE_LOOKUP(t) pgm_read_dword(&flame_palette[(t)])
+#endif
+
+void flame_enter() {
+    flame = mode_claim<FlameState>(); // 内存池已清零：画布是冷的，调色板尚未载入
+}
+
+/**
+ * @brief 选择火焰动画使用的调色板。
+ */
+void flame_set_palette(FlamePalette palette) {
+    if ((int)palette >= (int)FlamePalette::COUNT) palette = FlamePalette::CLASSIC;
+    flame_palette_id = palette;
+#if FLAME_PALETTE_IN_RAM
+    // 只记录编号：RAM 副本属于火焰动画的模式状态，由 flameEffect_lowRam() 在需要时载入
+#else
+    flame_palette = flame_palettes[(int)palette];
+#endif
+}
+
+/**
+ * @brief 获取当前火焰调色板编号。
+ */
+FlamePalette flame_get_palette() {
+    return flame_palette_id;
+}
+
 /**
  * @brief 将热度值 (0-255) 转换为对应的火焰颜色。
  *
- * 这是火焰效果的辅助函数。它将温度值映射到一个从黑 -> 红 -> 橙 -> 黄 的渐变
+ * 查当前调色板，代替原先每个像素最多三次 map() (含除法) 的计算。
  *
- * @param temperature 热度值，0为最冷（黑色），255为最热（亮黄色）。
+ * @param temperature 热度值，0为最冷（黑色），255为最热。
  * @return 返回一个32位的GRB格式颜色值。
  */
 uint32_t heatToColor_lowRam(byte temperature) {
-    if (temperature == 0) return 0; // 黑色
+    return FLAME_PALETTE_LOOKUP(temperature);
+}
 
-    // --- 计算 R, G, B 分量 ---
-    uint8_t r, g, b;
+// ---- 火焰热度图 (双缓冲，每行 8 个像素的热度打包成一个 uint64_t) ----
+// 字节 x 为第 x 列，第 0 行在最上方，火源在最下面一行。
 
-    // 黑(0,0,0) -> 深红(180,0,0)
-    if (temperature <= 85) {
-        r = map(temperature, 0, 85, 0, 180);
-        g = 0;
-        b = 0;
-    // 深红(180,0,0) -> 亮橙(255,100,0)
-    } else if (temperature <= 170) {
-        r = map(temperature, 86, 170, 180, 255);
-        g = map(temperature, 86, 170, 0, 100);
-        b = 0;
-    // 亮橙(255,100,0) -> 亮黄(255,255,0)
-    } else {
-        r = 255;
-        g = map(temperature, 171, 255, 100, 255);
-        b = 0;
-    }
+// SWAR 常量：每 16 位一个通道，用于在不溢出的情况下做加权求和
+const uint64_t SWAR_LANE_LO   = 0x00FF00FF00FF00FFULL; // 取偶数字节 (放到 16 位通道的低 8 位)
+const uint64_t SWAR_LANE_HALF = 0x7FFF7FFF7FFF7FFFULL; // 通道内右移 1 位后的掩码
+const uint64_t SWAR_LANE_ONE  = 0x0001000100010001ULL; // 每个 16 位通道加 1
+const uint64_t SWAR_BYTE_HIGH = 0x8080808080808080ULL; // 每个字节的最高位
 
-    // 组合成32位颜色值
-    return ((uint32_t)g << 16) | ((uint32_t)r << 8) | (uint32_t)b;
+/**
+ * @brief 按字节的饱和减法 a - b (小于0时取0)，8 个字节并行。
+ */
+static inline uint64_t swar_sub_sat_u8(uint64_t a, uint64_t b) {
+    // 各字节独立相减 (借位不跨字节)
+    uint64_t diff = ((a | SWAR_BYTE_HIGH) - (b & ~SWAR_BYTE_HIGH)) ^ ((a ^ ~b) & SWAR_BYTE_HIGH);
+    // 各字节是否发生借位 (a < b)
+    uint64_t borrow = ((~a & b) | (~(a ^ b) & diff)) & SWAR_BYTE_HIGH;
+    uint64_t lsb = borrow >> 7;
+    return diff & ~((lsb << 8) - lsb);
+}
+
+/**
+ * @brief 16 位通道内精确除以 6：先除以 2，再乘 85 右移 8 位 (85/256 ≈ 1/3)，最后修正一次。
+ * @details 输入每通道不超过 6*255=1530，中间结果不超过 765*85=65025，不会溢出到相邻通道。
+ *          乘 85 右移得到的商可能比 h/3 小 1，此时余数 h-3q 为 3..5，(余数+1)>>2 恰好补上这个 1。
+ *          乘法都用移位相加实现，Cortex-M0+ 上不需要 64 位乘法。
+ */
+static inline uint64_t swar_div6_u16(uint64_t s) {
+    uint64_t h = (s >> 1) & SWAR_LANE_HALF;
+    uint64_t m = (h << 6) + (h << 4) + (h << 2) + h;
+    uint64_t q = (m >> 8) & SWAR_LANE_LO;
+    // 3q <= h，通道内相减不会借位；右移时移入的相邻通道低位由掩码去掉
+    return q + (((h - ((q << 1) + q) + SWAR_LANE_ONE) >> 2) & SWAR_LANE_LO);
+}
+
+/**
+ * @brief 计算一整行的新热度。
+ * @param below 正下方一行。
+ * @param further 再下方一行。
+ * @return 新的一行：(正下*3 + 左下 + 右下 + 更下方) / 6。左右越界的邻居自然移入 0。
+ */
+static inline uint64_t flame_diffuse_row(uint64_t below, uint64_t further) {
+    uint64_t left  = below << 8; // 第 x 字节变为原第 x-1 字节 (左下)
+    uint64_t right = below >> 8; // 第 x 字节变为原第 x+1 字节 (右下)
+
+    // 偶数列与奇数列分别放在 16 位通道中求和
+    uint64_t e_below = below & SWAR_LANE_LO;
+    uint64_t o_below = (below >> 8) & SWAR_LANE_LO;
+    // 乘 3 写成移位相加，避免 64 位乘法 (__aeabi_lmul)
+    uint64_t sum_e = (e_below << 1) + e_below + (left & SWAR_LANE_LO) + (right & SWAR_LANE_LO)
+                   + (further & SWAR_LANE_LO);
+    uint64_t sum_o = (o_below << 1) + o_below + ((left >> 8) & SWAR_LANE_LO) + ((right >> 8) & SWAR_LANE_LO)
+                   + ((further >> 8) & SWAR_LANE_LO);
+
+    return swar_div6_u16(sum_e) | (swar_div6_u16(sum_o) << 8);
 }
 
 /**
  * @brief 在8x8 LED矩阵上生成一个低内存占用的逼真火焰动画。
  *
  * 该效果通过模拟像素冷却、热量向上传播以及在底部随机产生新火花来模拟火焰。
+ * 热量扩散使用双缓冲：新的一帧完全由上一帧计算得到，结果与遍历顺序无关；
+ * 火焰方向只影响最后的显示映射。
  *
  * @param ws SYC_WS2812驱动对象的引用。
  * @param cooling 冷却值，决定火焰熄灭的速度，值越大，冷却越快(建议值: 20-80)
@@ -69,51 +220,46 @@ void flameEffect_lowRam(SYC_WS2812& ws, int cooling, int sparking, bool reversed
     // 定义画布尺寸
     const int WIDTH = 8;
     const int HEIGHT = 8;
-    // 每个像素的热度
-    static uint8_t heat[ws2812_number];
+    uint64_t* src = flame->heat[flame->front];
+    uint64_t* dst = flame->heat[flame->front ^ 1];
+
+#if FLAME_PALETTE_IN_RAM
+    if (flame->palette_loaded != (uint8_t)flame_palette_id + 1) {
+        memcpy_P(flame->palette_ram, flame_palettes[(int)flame_palette_id], sizeof(flame->palette_ram));
+        flame->palette_loaded = (uint8_t)flame_palette_id + 1;
+    }
+#endif
 
-    // --- 步骤 1: 冷却画布 ---
-    for (int i = 0; i < ws2812_number; i++) {
-        int cooldown = random(0, ((cooling * 10) / HEIGHT) + 2);
-        heat[i] = (heat[i] > cooldown) ? (heat[i] - cooldown) : 0;
+    // --- 步骤 1: 冷却画布 (每个像素随机冷却，8 个像素一组做饱和减法) ---
+    // 第 0 行在扩散时不会被读取，无需冷却
+    int max_cooldown = ((cooling * 10) / HEIGHT) + 2;
+    for (int y = 1; y < HEIGHT; y++) {
+        src[y] = swar_sub_sat_u8(src[y], rng_bytes_below(RNG_STREAM_FLAME, max_cooldown));
     }
 
-    // --- 步骤 2: 热量扩散 ---
+    // --- 步骤 2: 热量扩散 (从 src 读取，写入 dst) ---
     for (int y = 0; y < HEIGHT; y++) {
-        for (int x = 0; x < WIDTH; x++) {
-            // 计算当前像素的索引 (行式排布)
-            int current_idx;
-            if (reversed) {
-                 current_idx = (HEIGHT - 1 - y) * WIDTH + x;
-            } else {
-                 current_idx = y * WIDTH + x;
-            }
-
-            // 读取下方三个像素(左下, 正下, 右下)以及更下方一个像素的热量，以产生更自然的火焰飘动效果
-            int heat_down_left  = (y < HEIGHT - 1 && x > 0)     ? heat[(y+1)*WIDTH + (x-1)] : 0;
-            int heat_down       = (y < HEIGHT - 1)              ? heat[(y+1)*WIDTH + x]     : 0;
-            int heat_down_right = (y < HEIGHT - 1 && x < WIDTH-1) ? heat[(y+1)*WIDTH + (x+1)] : 0;
-            int heat_further_down = (y < HEIGHT - 2)              ? heat[(y+2)*WIDTH + x]     : 0;
-
-            // 进行加权平均，模拟热空气不均匀地向上传播
-            int new_heat = (heat_down * 3 + heat_down_left + heat_down_right + heat_further_down) / 6;
-
-            // 将计算出的新热量写入当前像素
-            heat[current_idx] = new_heat;
-        }
+        uint64_t below   = (y < HEIGHT - 1) ? src[y + 1] : 0;
+        uint64_t further = (y < HEIGHT - 2) ? src[y + 2] : 0;
+        dst[y] = flame_diffuse_row(below, further);
     }
+    flame->front ^= 1;
 
     // --- 步骤 3: 在底部随机点燃火花 ---
-    if (random(255) < sparking) {
-        int x = random(1, WIDTH - 2);       // 不在最边缘点火，效果更自然
-        int y = reversed ? 0 : HEIGHT - 1;  // 在最下面一行
-        int spark_idx = y * WIDTH + x;
-        heat[spark_idx] = random(160, 255); // 赋予新火花一个高的初始热度
+    if (rng_below(RNG_STREAM_FLAME, 255) < sparking) {
+        int x = rng_range(RNG_STREAM_FLAME, 1, WIDTH - 2);      // 不在最边缘点火，效果更自然
+        uint64_t spark = rng_range(RNG_STREAM_FLAME, 160, 255); // 赋予新火花一个高的初始热度
+        dst[HEIGHT - 1] = (dst[HEIGHT - 1] & ~(0xFFULL << (x * 8))) | (spark << (x * 8));
     }
 
-    // --- 步骤 4: 将热度图映射为颜色并显示 ---
-    for (int i = 0; i < ws2812_number; i++) {
-        strip.setWs2812Color(i, heatToColor_lowRam(heat[i]));
+    // --- 步骤 4: 将热度图映射为颜色并显示 (反向时上下翻转) ---
+    for (int y = 0; y < HEIGHT; y++) {
+        uint64_t row = dst[y];
+        int base = (reversed ? (HEIGHT - 1 - y) : y) * WIDTH;
+        for (int x = 0; x < WIDTH; x++) {
+            ws.setWs2812Color(base + x, FLAME_PALETTE_LOOKUP((uint8_t)row));
+            row >>= 8;
+        }
     }
 }
 
@@ -132,15 +278,12 @@ void flameEffect_lowRam(SYC_WS2812& ws, int cooling, int sparking, bool reversed
  * @param density 控制彩虹的密度，值越大颜色带越多、越窄。
  */
 void anim_rainbow_flow(SYC_WS2812& ws, uint8_t speed, uint8_t density) {
-    // 计算时间分量
-    uint32_t time_component = millis() / (100 / speed);
-
-    for (int i = 0; i < ws2812_number; i++) {
-        byte hue = (i * density + time_component) & 255;
-        uint32_t color = ws.Wheel(hue);
-        // 使用 setWs2812Color 函数来应用亮度并设置像素颜色
-        ws.setWs2812Color(i, color);
-    }
+    // 计算时间分量：色相每毫秒前进 speed / 100 格 (Q8.8，256 / 100 ≈ 655 / 256)，
+    // 用乘法代替原先的 100 / speed，speed > 100 时也不会除零
+    uint16_t hue = (uint16_t)((millis() * speed * 655UL) >> 8);
+
+    // 整帧按色相增量批量填充，相邻像素相差 density 格
+    hsv_fill(ws, 0, ws2812_number, hue, (int16_t)(density << 8), 255, 255);
 }
 
 
@@ -176,81 +319,100 @@ void anim_beating_heart(SYC_WS2812& ws, uint16_t interval) {
 }
 
 /******************************************************************************
- *                         流星雨动画 (Meteor Shower)
+ *                      粒子动画 (Particle Animations)
  ******************************************************************************/
 
-bool meteor_animation_initialized = false;
-Meteor meteor_pool[MAX_METEORS];
+// 坐标和速度均为 Q8.8 (像素、像素/秒)
+#define PX(v) ((int16_t)((v) * 256))
 
 /**
- * @brief 初始化流星雨动画。
+ * @brief 各粒子效果的发射器配置，按 ParticleEffect 编号排列。
  */
-void init_meteor_shower() {
-    for (int i = 0; i < MAX_METEORS; i++) {
-        meteor_pool[i].is_active = false; 
-    }
-    strip.clearWs2812(); // 清空屏幕
-    meteor_animation_initialized = true;
-}
+static const ParticleEmitterConfig particle_effects[(int)ParticleEffect::COUNT] PROGMEM = {
+    // 流星雨：从顶部随机列落下，平均每秒约 1.4 颗，颜色随机，靠整帧淡出形成拖尾
+    {
+        .rate = PX(1.4), .burst_interval_ms = 0, .burst_count = 0, .flags = 0,
+        .x_min = PX(0), .x_max = PX(7.99), .y_min = PX(-0.5), .y_max = PX(0),
+        .vx = 0, .vy = PX(15), .vx_spread = 0, .vy_spread = PX(7.5),
+        .radial_min = 0, .radial_max = 0,
+        .gravity = 0, .drag = 0,
+        .hue = 0, .hue_spread = 255,
+        .life_min_ms = 3000, .life_max_ms = 3000,
+        .ramp = {{0, 255, 255}, {0, 255, 255}, {0, 255, 255}, {0, 255, 255}}
+    },
+    // 烟花：每隔一段时间在上半部分炸开，白热 -> 彩色 -> 熄灭，受重力和空气阻力影响
+    {
+        .rate = 0, .burst_interval_ms = 1100, .burst_count = 14, .flags = PARTICLE_RADIAL,
+        .x_min = PX(2), .x_max = PX(6), .y_min = PX(1), .y_max = PX(4),
+        .vx = 0, .vy = 0, .vx_spread = PX(0.5), .vy_spread = PX(0.5),
+        .radial_min = PX(3), .radial_max = PX(7),
+        .gravity = PX(5), .drag = 100,
+        .hue = 0, .hue_spread = 255,
+        .life_min_ms = 900, .life_max_ms = 1400,
+        .ramp = {{0, 0, 255}, {0, 255, 255}, {0, 255, 150}, {0, 255, 0}}
+    },
+    // 雨滴：斜向落下的蓝色雨滴
+    {
+        .rate = PX(14), .burst_interval_ms = 0, .burst_count = 0, .flags = 0,
+        .x_min = PX(-1), .x_max = PX(7.99), .y_min = PX(-1), .y_max = PX(0),
+        .vx = PX(1), .vy = PX(11), .vx_spread = PX(0.5), .vy_spread = PX(2),
+        .radial_min = 0, .radial_max = 0,
+        .gravity = PX(4), .drag = 0,
+        .hue = 150, .hue_spread = 25,
+        .life_min_ms = 2000, .life_max_ms = 2000,
+        .ramp = {{0, 200, 220}, {0, 220, 200}, {0, 240, 160}, {0, 255, 120}}
+    },
+    // 火花：从底部中央向上喷出，重力拉回，黄 -> 橙 -> 红 -> 熄灭
+    {
+        .rate = PX(30), .burst_interval_ms = 0, .burst_count = 0, .flags = 0,
+        .x_min = PX(3), .x_max = PX(4.99), .y_min = PX(7), .y_max = PX(7.99),
+        .vx = 0, .vy = PX(-9), .vx_spread = PX(3), .vy_spread = PX(3),
+        .radial_min = 0, .radial_max = 0,
+        .gravity = PX(10), .drag = 40,
+        .hue = 40, .hue_spread = 10,
+        .life_min_ms = 600, .life_max_ms = 1100,
+        .ramp = {{10, 120, 255}, {0, 255, 255}, {-20, 255, 180}, {-35, 255, 0}}
+    },
+};
 
 /**
- * @brief 渲染一个带拖尾效果的流星雨动画。
- * @param ws SYC_WS2812驱动对象的引用。
- * @param new_meteor_chance 每一帧产生新流星的概率 (0-255)，建议值为 10-40。
+ * @brief 各粒子效果的拖尾淡出速度，按 ParticleEffect 编号排列。
  */
-void anim_meteor_shower(SYC_WS2812& ws, uint8_t new_meteor_chance) {
-    // 如果动画是首次运行，则进行初始化
-    if (!meteor_animation_initialized) {
-        init_meteor_shower();
-    }
+static const uint8_t particle_effect_fade[(int)ParticleEffect::COUNT] = {
+    FADE_RATE, 96, 110, 140
+};
 
-    // ---- 1. 绘制拖尾效果 ----
-    for (int i = 0; i < ws2812_number; i++) {
-        uint32_t color = ws.led_data[i];
-        uint8_t r = (color >> 16) & 0xFF;
-        uint8_t g = (color >> 8) & 0xFF;
-        uint8_t b = color & 0xFF;
+// 当前运行的粒子效果 (COUNT 表示未运行)
+static ParticleEffect particle_running = ParticleEffect::COUNT;
 
-        r = (r <= FADE_RATE) ? 0 : r - FADE_RATE;
-        g = (g <= FADE_RATE) ? 0 : g - FADE_RATE;
-        b = (b <= FADE_RATE) ? 0 : b - FADE_RATE;
+void anim_particles_enter(void) {
+    particles_enter();
+    particle_running = ParticleEffect::COUNT;
+}
 
-        ws.led_data[i] = ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
-    }
+void anim_particles_stop(void) {
+    particles_reset();
+    particle_running = ParticleEffect::COUNT;
+}
 
-    // --- 2. 生成一颗新的流星 ---
-    if (random(255) < new_meteor_chance) {
-        for (int i = 0; i < MAX_METEORS; i++) {
-            if (!meteor_pool[i].is_active) {
-                meteor_pool[i].is_active = true;
-                meteor_pool[i].x = random(8) << 8;
-                meteor_pool[i].y = 0;
-                meteor_pool[i].speed = random(256, 768);
-                // 流星的颜色
-                meteor_pool[i].hue = random(0, 256);
-                break; // 找到后即退出循环
-            }
-        }
+/**
+ * @brief 推进并渲染一个带拖尾效果的粒子动画。
+ */
+void anim_particles(SYC_WS2812& ws, ParticleEffect effect, uint16_t dt_ms) {
+    // 效果变化时重新开始：清空粒子池和画面，启动对应的发射器
+    if (effect != particle_running) {
+        particles_reset();
+        particle_emitter_start(&particle_effects[(int)effect]);
+        ws.clearWs2812();
+        particle_running = effect;
     }
 
-    // ---- 3. 移动并绘制所有活动的流星 ----
-    for (int i = 0; i < MAX_METEORS; i++) {
-        if (meteor_pool[i].is_active) {
-            meteor_pool[i].y += meteor_pool[i].speed / 4;
-
-            if (meteor_pool[i].y >= (8 << 8)) {
-                meteor_pool[i].is_active = false;
-            } else {
-                int x_pos = meteor_pool[i].x >> 8;
-                int y_pos = meteor_pool[i].y >> 8;
-
-                int index = y_pos * 8 + x_pos;
-                if (index >= 0 && index < ws2812_number) {
-                    ws.led_data[index] = ws.Wheel(meteor_pool[i].hue);
-                }
-            }
-        }
-    }
+    // ---- 1. 绘制拖尾效果 (整帧淡出) ----
+    frame_fade(ws.led_data, ws2812_number, particle_effect_fade[(int)effect]);
+
+    // ---- 2. 发射、移动并绘制所有粒子 ----
+    particles_update(dt_ms);
+    particles_render(ws);
 }
 
 
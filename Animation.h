@@ -12,19 +12,17 @@
 #ifndef _ANIMATION_H_
 #define _ANIMATION_H_
 
-#include "Device.h" // 引入设备驱动，其中应包含 SYC_WS2812 类和 Meteor 结构体的定义
+#include "Device.h" // 引入设备驱动，其中应包含 SYC_WS2812 类的定义
+#include "Random.h"
+#include "Color.h"
+#include "Pixel.h"
+#include "Particle.h"
 
 /******************************************************************************
  *                        动画配置宏与全局变量 (Configurations)
  ******************************************************************************/
 
-// --- 流星雨动画配置 (Meteor Shower Settings) ---
-
-/**
- * @brief 定义屏幕上可以同时存在的最大流星数量。
- * @note 增加此值会轻微增加RAM使用量。
- */
-#define MAX_METEORS 5
+// --- 粒子动画配置 (Particle Animation Settings) ---
 
 /**
  * @brief 定义流星拖尾的渐隐速度 (0-255)。
@@ -33,16 +31,48 @@
 #define FADE_RATE   64
 
 /**
- * @brief 外部变量，用于标记流星雨动画是否已初始化。
- * @details 在 .cpp 文件中定义，确保 `init_meteor_shower()` 只被调用一次。
+ * @brief 基于粒子系统的动画效果，每种效果对应一个发射器配置。
  */
-extern bool meteor_animation_initialized;
+enum class ParticleEffect {
+    METEOR,    // 流星雨
+    FIREWORKS, // 烟花
+    RAIN,      // 雨滴
+    SPARKS,    // 火花
+    COUNT
+};
+
+// --- 火焰调色板配置 (Flame Palette Settings) ---
 
 /**
- * @brief 外部变量，流星对象池数组。
- * @details 在 .cpp 文件中定义，用于存储和管理所有流星的状态。
+ * @brief 为 1 时将当前火焰调色板复制到 RAM (1KB)，为 0 时直接从 Flash 查表。
+ * @note Flash 模式下切换调色板只是一次指针交换。
  */
-extern Meteor meteor_pool[];
+#ifndef FLAME_PALETTE_IN_RAM
+#define FLAME_PALETTE_IN_RAM 0
+#endif
+
+/**
+ * @brief 火焰动画的工作状态 (由 flame_enter() 从模式内存池申请，全零即为冷却的画布)。
+ */
+struct FlameState {
+    uint64_t heat[2][8];       // 热度图双缓冲，每行 8 个像素的热度打包成一个 uint64_t
+    uint8_t front;             // 当前有效的缓冲区
+#if FLAME_PALETTE_IN_RAM
+    uint8_t palette_loaded;    // palette_ram 中已载入的调色板编号 + 1，0 表示尚未载入
+    uint32_t palette_ram[256]; // 当前调色板在 RAM 中的副本
+#endif
+};
+
+/**
+ * @brief 可选的火焰调色板。
+ */
+enum class FlamePalette {
+    CLASSIC,     // 经典火焰: 黑 -> 红 -> 橙 -> 黄
+    BLUE_GAS,    // 燃气蓝焰: 黑 -> 深蓝 -> 青 -> 白
+    TOXIC_GREEN, // 毒气绿焰: 黑 -> 墨绿 -> 荧光绿 -> 黄白
+    PURPLE,      // 魔法紫焰: 黑 -> 紫 -> 粉 -> 白
+    COUNT
+};
 
 
 /******************************************************************************
@@ -60,13 +90,29 @@ extern Meteor meteor_pool[];
  */
 void flameEffect_lowRam(SYC_WS2812& ws, int cooling, int sparking, bool reversed);
 
+/**
+ * @brief 进入火焰动画：从模式内存池申请热度图，调用 flameEffect_lowRam() 之前必须先进入。
+ */
+void flame_enter(void);
+
 /**
  * @brief (辅助函数) 将热度值 (0-255) 转换为对应的火焰颜色。
  * @param temperature 热度值，0为最冷，255为最热。
- * @return 32位的GRB格式颜色值。
+ * @return 32位的GRB格式颜色值 (查当前调色板)。
  */
 uint32_t heatToColor_lowRam(byte temperature);
 
+/**
+ * @brief 选择火焰动画使用的调色板。
+ * @param palette 调色板编号。
+ */
+void flame_set_palette(FlamePalette palette);
+
+/**
+ * @brief 获取当前火焰调色板编号。
+ */
+FlamePalette flame_get_palette(void);
+
 
 // ======== 彩虹动画 (Rainbow Animation) ========
 
@@ -96,18 +142,26 @@ void anim_beating_heart(SYC_WS2812& ws, uint16_t interval);
 void anim_logo(SYC_WS2812& ws, uint16_t interval);
 
 
-// ======== 流星雨动画 (Meteor Shower Animation) ========
+// ======== 粒子动画 (Particle Animations) ========
 
 /**
- * @brief 渲染一个带拖尾效果的流星雨动画。
+ * @brief 推进并渲染一个带拖尾效果的粒子动画 (流星雨、烟花、雨滴、火花)。
+ * @details 在上一帧的画面上整体淡出后再叠加绘制粒子，因此需要保留上一帧画面。
+ *          效果变化时清空粒子池和画面，并启动对应的发射器。
  * @param ws SYC_WS2812驱动对象的引用。
- * @param new_meteor_chance 每一帧产生新流星的概率 (0-255)，建议值为 10-40。
+ * @param effect 粒子效果。
+ * @param dt_ms 时间步长 (单位: 毫秒)。
+ */
+void anim_particles(SYC_WS2812& ws, ParticleEffect effect, uint16_t dt_ms);
+
+/**
+ * @brief 进入粒子动画：从模式内存池申请粒子池，调用 anim_particles() 之前必须先进入。
  */
-void anim_meteor_shower(SYC_WS2812& ws, uint8_t new_meteor_chance);
+void anim_particles_enter(void);
 
 /**
- * @brief (辅助函数) 初始化流星雨动画，重置所有流星状态。
+ * @brief 停止粒子动画，下一次调用 anim_particles() 时重新开始。
  */
-void init_meteor_shower(void);
+void anim_particles_stop(void);
 
 #endif
\ No newline at end of file
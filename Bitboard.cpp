@@ -0,0 +1,223 @@
+/**
+ * @file Bitboard.cpp
+ * @author 多嘴龙虾
+ * @brief 8x8 位棋盘 (bitboard) 图形库
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * 本文件包含位棋盘中不适合内联的操作：任意平移、行内循环平移、
+ * 末尾零计数、第 n 个置位查找、邻居计数 (位棋盘与行位图共用同一套位切片加法器)，
+ * 以及位图载入和绘制。
+ */
+
+#include "Bitboard.h"
+#include "Color.h"
+
+/**
+ * @brief 任意方向平移，移出边界的像素被丢弃。
+ */
+Bitboard bb_shift(Bitboard b, int dx, int dy) {
+    if (dx <= -8 || dx >= 8 || dy <= -8 || dy >= 8) return BB_EMPTY;
+
+    // 先做水平平移：屏蔽掉会越过行边界的列
+    if (dx > 0) {
+        Bitboard keep = BB_COL_0 * (uint8_t)(0xFF >> dx);  // 平移后仍在行内的列
+        b = (b & keep) << dx;
+    } else if (dx < 0) {
+        Bitboard keep = BB_COL_0 * (uint8_t)(0xFF << -dx);
+        b = (b & keep) >> -dx;
+    }
+    // 再做垂直平移
+    if (dy > 0) {
+        b <<= dy * 8;
+    } else if (dy < 0) {
+        b >>= -dy * 8;
+    }
+    return b;
+}
+
+/**
+ * @brief 每一行内左右循环平移 dx 列 (正值向右)。
+ */
+Bitboard bb_roll_cols(Bitboard b, int dx) {
+    int s = dx & 7;
+    if (s == 0) return b;
+    Bitboard right_part = BB_COL_0 * (uint8_t)(0xFF >> s);  // 向右移动不越界的列
+    return ((b & right_part) << s) | ((b & ~right_part) >> (8 - s));
+}
+
+// de Bruijn 序列 0x077CB531 对应的末尾零位置表
+static const uint8_t debruijn_ctz32[32] PROGMEM = {
+    0, 1, 28, 2, 29, 14, 24, 3, 30, 22, 20, 15, 25, 17, 4, 8,
+    31, 27, 13, 23, 21, 19, 16, 7, 26, 12, 18, 6, 11, 5, 10, 9
+};
+
+/**
+ * @brief 32 位末尾零计数。
+ */
+uint8_t bb_ctz32(uint32_t v) {
+    return pgm_read_byte(&debruijn_ctz32[((v & (0u - v)) * 0x077CB531u) >> 27]);
+}
+
+/**
+ * @brief 第 n 个置位的索引。
+ * @details 先按字节累计置位数定位到所在字节，再在字节内逐个清除低位，
+ *          最多 8 + 7 步，与棋盘内容无关。
+ */
+uint8_t bb_select(Bitboard b, uint8_t n) {
+    uint8_t base = 0;
+    for (uint8_t row = 0; row < 8; row++) {
+        uint8_t cnt = bb_popcount32((uint32_t)((b >> base) & 0xFF));
+        if (n < cnt) break;
+        n -= cnt;
+        base += 8;
+    }
+    uint32_t byte = (uint32_t)((b >> base) & 0xFF);
+    while (n--) byte &= byte - 1;
+    return base + bb_ctz32(byte);
+}
+
+/**
+ * @brief 三个位平面的全加器：返回本位和，进位写入 carry。
+ * @details 以下加法器和选择树对 64 位棋盘与 32 位行位图通用，T 为每个位平面的类型。
+ */
+template <typename T>
+static inline T bb_full_add(T a, T b, T c, T& carry) {
+    T t = a ^ b;
+    carry = (a & b) | (t & c);
+    return t ^ c;
+}
+
+/**
+ * @brief 把 8 个邻居平移副本逐位相加，得到 4 个计数位平面。
+ * @details 先分三组相加得到各自的 1 位和与 2 位进位，再逐级合并进位，共 7 个加法器。
+ */
+template <typename T>
+static void bb_add_neighbors(T n0, T n1, T n2, T n3, T n4, T n5, T n6, T n7, T (&count)[4]) {
+    // 第一级：三组分别求和，得到权重 1 的和与权重 2 的进位
+    T c_a, c_b;
+    T s_a = bb_full_add(n0, n1, n2, c_a);
+    T s_b = bb_full_add(n3, n4, n5, c_b);
+    T s_c = n6 ^ n7;
+    T c_c = n6 & n7;
+
+    // 第二级：权重 1 的三个和相加
+    T c_1;
+    count[0] = bb_full_add(s_a, s_b, s_c, c_1);
+
+    // 第三级：权重 2 的四个进位相加
+    T c_2;
+    T t = bb_full_add(c_a, c_b, c_c, c_2);
+    count[1] = t ^ c_1;
+    T c_3 = t & c_1;
+
+    // 第四级：权重 4 的两个进位相加
+    count[2] = c_2 ^ c_3;
+    count[3] = c_2 & c_3;
+}
+
+/**
+ * @brief 计数属于集合 set 的格子。
+ * @details 把 set 看作 4 个位平面的真值表，按 bit[3] → bit[0] 对半划分，
+ *          每一层用 bit[LEVEL] 在两半的结果之间选择。某一半的真值全为 0 或全为 1 时
+ *          直接得到常量，所以稀疏的规则 (如 B3/S23) 只需要少量运算。
+ *          层数作为模板参数，整棵树在编译期展开，没有递归调用。
+ * @param set 从计数 0 开始的真值表 (已移到第 0 位)。
+ */
+template <typename T, uint8_t LEVEL>
+struct BbCountSelect {
+    static inline T eval(const T (&c)[4], uint16_t set) {
+        const uint8_t half = 1 << LEVEL;
+        const uint16_t all = (1u << (2 * half)) - 1;
+        set &= all;
+        if (set == 0) return 0;
+        if (set == all) return (T)~(T)0;
+        T lo = BbCountSelect<T, LEVEL - 1>::eval(c, set);
+        T hi = BbCountSelect<T, LEVEL - 1>::eval(c, set >> half);
+        return (lo & ~c[LEVEL]) | (hi & c[LEVEL]);
+    }
+};
+
+template <typename T>
+struct BbCountSelect<T, 0> {
+    static inline T eval(const T (&c)[4], uint16_t set) {
+        switch (set & 3) {
+            case 0: return 0;
+            case 1: return ~c[0];  // 只有偶数项在集合中
+            case 2: return c[0];   // 只有奇数项在集合中
+            default: return (T)~(T)0;
+        }
+    }
+};
+
+template <typename T>
+static inline T bb_select_count(const T (&c)[4], uint16_t set) {
+    return BbCountSelect<T, 3>::eval(c, set & 0x1FF); // 计数最大为 8
+}
+
+/**
+ * @brief 单行 8 邻居计数，行宽 width (1-32)。
+ */
+void bb_row_neighbor_count(uint32_t above, uint32_t row, uint32_t below,
+                           uint8_t width, bool wrap, RowCount& count) {
+    // left: 左边的邻居移到本列；right: 右边的邻居移到本列
+    uint32_t mask = bb_row_mask(width);
+    uint32_t la = (above << 1) & mask, ra = above >> 1;
+    uint32_t lr = (row << 1) & mask,   rr = row >> 1;
+    uint32_t lb = (below << 1) & mask, rb = below >> 1;
+    if (wrap) {
+        uint8_t last = width - 1;
+        la |= above >> last; ra |= (above & 1) << last;
+        lr |= row >> last;   rr |= (row & 1) << last;
+        lb |= below >> last; rb |= (below & 1) << last;
+    }
+    bb_add_neighbors(la, above, ra,
+                     lr,        rr,
+                     lb, below, rb,
+                     count.bit);
+}
+
+/**
+ * @brief 单行计数属于集合 set 的格子。
+ */
+uint32_t bb_row_count_in(const RowCount& c, uint16_t set) {
+    return bb_select_count(c.bit, set);
+}
+
+/**
+ * @brief 32 位位序反转。
+ */
+static uint32_t reverse_bits32(uint32_t v) {
+    v = ((v >> 1) & 0x55555555u) | ((v & 0x55555555u) << 1);
+    v = ((v >> 2) & 0x33333333u) | ((v & 0x33333333u) << 2);
+    v = ((v >> 4) & 0x0F0F0F0Fu) | ((v & 0x0F0F0F0Fu) << 4);
+    v = ((v >> 8) & 0x00FF00FFu) | ((v & 0x00FF00FFu) << 8);
+    return (v >> 16) | (v << 16);
+}
+
+/**
+ * @brief 从 PROGMEM 位图载入位棋盘。
+ * @details 位图中 LED i 位于 num[i / 32] 的第 (31 - i % 32) 位，位序反转后即为位棋盘布局。
+ */
+Bitboard bb_from_bitmap(const uint32_t* num) {
+    uint32_t hi = pgm_read_dword(&num[0]);
+    uint32_t lo = pgm_read_dword(&num[1]);
+    return (Bitboard)reverse_bits32(hi) | ((Bitboard)reverse_bits32(lo) << 32);
+}
+
+/**
+ * @brief 将位棋盘中置位的像素设为同一种颜色。
+ */
+void bb_draw(SYC_WS2812& ws, Bitboard b, uint32_t color) {
+    while (b) {
+        ws.setWs2812Color(bb_pop_lsb(b), color);
+    }
+}
+
+/**
+ * @brief 将位棋盘中置位的像素按彩虹色绘制。
+ */
+void bb_draw_rainbow(SYC_WS2812& ws, Bitboard b, uint8_t hue, uint8_t hue_step) {
+    hsv_fill_mask(ws, b, (uint16_t)hue << 8, (int16_t)(hue_step << 8), 255, 255);
+}
@@ -0,0 +1,266 @@
+/**
+ * @file Bitboard.h
+ * @author 多嘴龙虾
+ * @brief 8x8 位棋盘 (bitboard) 图形库
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * 用一个 uint64_t 表示整块 8x8 LED 矩阵，第 i 位对应 LED 索引 i (i = y * 8 + x)，
+ * 即第 y 个字节是第 y 行，字节内第 x 位是第 x 列。
+ *
+ * 所有操作 (平移、旋转、镜像、转置、布尔运算、计数、遍历置位) 都是常数时间，
+ * 不含逐像素循环和分支，适合没有桶形移位器和硬件除法的 Cortex-M0+。
+ * Bitmap.cpp 中的位图 (两个 uint32_t，高位在前) 可通过 bb_from_bitmap() 载入。
+ */
+
+#ifndef _BITBOARD_H_
+#define _BITBOARD_H_
+
+#include "Device.h"
+
+/**
+ * @brief 8x8 位棋盘类型。
+ */
+typedef uint64_t Bitboard;
+
+// --- 常用掩码 ---
+const Bitboard BB_EMPTY  = 0;
+const Bitboard BB_FULL   = ~(Bitboard)0;
+const Bitboard BB_COL_0  = 0x0101010101010101ULL; // 最左列 (x = 0)
+const Bitboard BB_COL_7  = 0x8080808080808080ULL; // 最右列 (x = 7)
+const Bitboard BB_ROW_0  = 0x00000000000000FFULL; // 最上行 (y = 0)
+const Bitboard BB_ROW_7  = 0xFF00000000000000ULL; // 最下行 (y = 7)
+const Bitboard BB_BORDER = BB_COL_0 | BB_COL_7 | BB_ROW_0 | BB_ROW_7;
+
+/******************************************************************************
+ *                              单个像素
+ ******************************************************************************/
+
+/**
+ * @brief 坐标对应的单比特掩码。
+ */
+inline Bitboard bb_bit(int x, int y) {
+    return (Bitboard)1 << (y * 8 + x);
+}
+
+/**
+ * @brief 读取坐标 (x, y) 的状态，越界视为 0。
+ */
+inline bool bb_test(Bitboard b, int x, int y) {
+    if ((unsigned)x >= 8 || (unsigned)y >= 8) return false;
+    return (b >> (y * 8 + x)) & 1;
+}
+
+/**
+ * @brief 读取 LED 索引 index 的状态。
+ */
+inline bool bb_test_index(Bitboard b, int index) {
+    return (b >> index) & 1;
+}
+
+/******************************************************************************
+ *                        平移 (移出边界的像素被丢弃)
+ ******************************************************************************/
+
+inline Bitboard bb_shift_up(Bitboard b)    { return b >> 8; }
+inline Bitboard bb_shift_down(Bitboard b)  { return b << 8; }
+inline Bitboard bb_shift_left(Bitboard b)  { return (b >> 1) & ~BB_COL_7; }
+inline Bitboard bb_shift_right(Bitboard b) { return (b << 1) & ~BB_COL_0; }
+
+/**
+ * @brief 所有置位格子的上下左右四邻 (不含自身)，用于位棋盘上的逐层洪水填充。
+ */
+inline Bitboard bb_neighbors4(Bitboard b) {
+    return bb_shift_up(b) | bb_shift_down(b) | bb_shift_left(b) | bb_shift_right(b);
+}
+
+/**
+ * @brief 任意方向平移 (dx, dy 取值 -7..7)。
+ */
+Bitboard bb_shift(Bitboard b, int dx, int dy);
+
+/******************************************************************************
+ *                     循环平移 (移出的像素从另一侧进入)
+ ******************************************************************************/
+
+/**
+ * @brief 整体上下循环平移 dy 行 (正值向下)。
+ */
+inline Bitboard bb_roll_rows(Bitboard b, int dy) {
+    unsigned s = (unsigned)(dy & 7) * 8;
+    return s ? (b << s) | (b >> (64 - s)) : b;
+}
+
+/**
+ * @brief 每一行内左右循环平移 dx 列 (正值向右)。
+ */
+Bitboard bb_roll_cols(Bitboard b, int dx);
+
+/******************************************************************************
+ *                        镜像、翻转、转置、旋转
+ ******************************************************************************/
+
+/**
+ * @brief 左右镜像 (每个字节内位序反转)。
+ */
+inline Bitboard bb_mirror(Bitboard b) {
+    b = ((b >> 1) & 0x5555555555555555ULL) | ((b & 0x5555555555555555ULL) << 1);
+    b = ((b >> 2) & 0x3333333333333333ULL) | ((b & 0x3333333333333333ULL) << 2);
+    b = ((b >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((b & 0x0F0F0F0F0F0F0F0FULL) << 4);
+    return b;
+}
+
+/**
+ * @brief 上下翻转 (字节序反转)。
+ */
+inline Bitboard bb_flip(Bitboard b) {
+    b = ((b >> 8)  & 0x00FF00FF00FF00FFULL) | ((b & 0x00FF00FF00FF00FFULL) << 8);
+    b = ((b >> 16) & 0x0000FFFF0000FFFFULL) | ((b & 0x0000FFFF0000FFFFULL) << 16);
+    return (b >> 32) | (b << 32);
+}
+
+/**
+ * @brief 沿主对角线转置 ((x, y) -> (y, x))。
+ */
+inline Bitboard bb_transpose(Bitboard b) {
+    Bitboard t;
+    t = 0x0F0F0F0F00000000ULL & (b ^ (b << 28));
+    b ^= t ^ (t >> 28);
+    t = 0x3333000033330000ULL & (b ^ (b << 14));
+    b ^= t ^ (t >> 14);
+    t = 0x5500550055005500ULL & (b ^ (b << 7));
+    b ^= t ^ (t >> 7);
+    return b;
+}
+
+/**
+ * @brief 顺时针旋转 90 度。
+ */
+inline Bitboard bb_rotate_cw(Bitboard b) {
+    return bb_mirror(bb_transpose(b));
+}
+
+/**
+ * @brief 逆时针旋转 90 度。
+ */
+inline Bitboard bb_rotate_ccw(Bitboard b) {
+    return bb_flip(bb_transpose(b));
+}
+
+/**
+ * @brief 旋转 180 度。
+ */
+inline Bitboard bb_rotate_180(Bitboard b) {
+    return bb_flip(bb_mirror(b));
+}
+
+/******************************************************************************
+ *                             计数与遍历
+ ******************************************************************************/
+
+/**
+ * @brief 32 位置位计数 (SWAR，常数时间)。
+ */
+inline uint8_t bb_popcount32(uint32_t v) {
+    v = v - ((v >> 1) & 0x55555555u);
+    v = (v & 0x33333333u) + ((v >> 2) & 0x33333333u);
+    v = (v + (v >> 4)) & 0x0F0F0F0Fu;
+    return (uint8_t)((v * 0x01010101u) >> 24);
+}
+
+/**
+ * @brief 置位计数。
+ */
+inline uint8_t bb_popcount(Bitboard b) {
+    return bb_popcount32((uint32_t)b) + bb_popcount32((uint32_t)(b >> 32));
+}
+
+/**
+ * @brief 32 位末尾零计数 (de Bruijn 乘法查表，v 不能为 0)。
+ */
+uint8_t bb_ctz32(uint32_t v);
+
+/**
+ * @brief 最低置位的索引 (b 不能为 0)。
+ */
+inline uint8_t bb_ctz(Bitboard b) {
+    uint32_t lo = (uint32_t)b;
+    return lo ? bb_ctz32(lo) : 32 + bb_ctz32((uint32_t)(b >> 32));
+}
+
+/**
+ * @brief 取出并清除最低置位，返回其索引 (b 不能为 0)。
+ * @details 典型用法：while (b) { uint8_t i = bb_pop_lsb(b); ... }
+ */
+inline uint8_t bb_pop_lsb(Bitboard& b) {
+    uint8_t i = bb_ctz(b);
+    b &= b - 1;
+    return i;
+}
+
+/**
+ * @brief 第 n 个 (从 0 开始) 置位的索引，n 必须小于 bb_popcount(b)。
+ */
+uint8_t bb_select(Bitboard b, uint8_t n);
+
+/******************************************************************************
+ *                     行位图 (宽度不超过 32 的大世界)
+ ******************************************************************************/
+
+/**
+ * @brief 一行最多 32 个格子的计数位平面，第 x 位对应第 x 列。
+ * @details 大于 8x8 的世界按行存成 uint32_t 数组，逐行 (逐字) 做与位棋盘相同的位切片加法。
+ */
+struct RowCount {
+    uint32_t bit[4];
+};
+
+/**
+ * @brief 宽度为 width (1-32) 的行中有效列的掩码。
+ */
+inline uint32_t bb_row_mask(uint8_t width) {
+    return width >= 32 ? 0xFFFFFFFFUL : ((1UL << width) - 1);
+}
+
+/**
+ * @brief 计算一行中每个格子的 8 邻居置位数量。
+ * @param above 上一行 (没有上一行时传 0)。
+ * @param row 本行。
+ * @param below 下一行 (没有下一行时传 0)。
+ * @param width 行宽 (1-32)。
+ * @param wrap 为 true 时左右边界相连。
+ */
+void bb_row_neighbor_count(uint32_t above, uint32_t row, uint32_t below,
+                           uint8_t width, bool wrap, RowCount& count);
+
+/**
+ * @brief 计数属于集合 set 的格子 (set 的第 n 位为 1 表示计数 n 在集合中)。
+ * @details 把 set 看作 4 个位平面的真值表，用多路选择树逐级求值：
+ *          先按 bit[0] 把相邻两项合成 8 个结果，再依次按 bit[1]、bit[2]、bit[3] 合并，
+ *          与集合中有多少个元素无关。
+ */
+uint32_t bb_row_count_in(const RowCount& c, uint16_t set);
+
+/******************************************************************************
+ *                           位图载入与绘制
+ ******************************************************************************/
+
+/**
+ * @brief 从 PROGMEM 位图 (两个 uint32_t，高位对应较小的LED索引) 载入位棋盘。
+ */
+Bitboard bb_from_bitmap(const uint32_t* num);
+
+/**
+ * @brief 将位棋盘中置位的像素设为同一种颜色，未置位的像素不受影响。
+ */
+void bb_draw(SYC_WS2812& ws, Bitboard b, uint32_t color);
+
+/**
+ * @brief 将位棋盘中置位的像素按彩虹色绘制。
+ * @param hue 起始色相。
+ * @param hue_step 相邻LED索引之间的色相增量。
+ */
+void bb_draw_rainbow(SYC_WS2812& ws, Bitboard b, uint8_t hue, uint8_t hue_step);
+
+#endif
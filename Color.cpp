@@ -0,0 +1,144 @@
+/**
+ * @file Color.cpp
+ * @author 多嘴龙虾
+ * @brief 定点 HSV 颜色引擎
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * 本文件实现了 HSV 到 GRB 的定点转换：
+ * - 三个通道共用一条编译期生成的曲线，彼此相差三分之一圈。
+ * - 曲线用 smoothstep 代替 Wheel() 的折线，原色附近过渡更平滑，
+ *   且相邻两个通道之和保持不变，整圈亮度均匀。
+ * - 色相的小数部分在相邻两项之间线性插值，慢速流动时颜色连续变化而不是逐格跳变。
+ * - 饱和度和明度只用乘法和移位，全饱和全明度时直接查表。
+ */
+
+#include "Color.h"
+
+// ---- 通道曲线 (编译期生成的 256 项查找表) ----
+
+/**
+ * @brief 256 项通道曲线。
+ */
+struct HueRamp {
+    uint8_t level[256];
+};
+
+// 一个色区的长度 (整圈 256 分为 85 + 85 + 86)
+constexpr int HUE_SECTOR = 85;
+
+/**
+ * @brief smoothstep 上升沿: 255 * (3t² - 2t³)，t = x / HUE_SECTOR。
+ */
+constexpr uint8_t hue_rise(long x) {
+    return (uint8_t)((255L * x * x * (3 * HUE_SECTOR - 2 * x) + HUE_SECTOR * HUE_SECTOR * HUE_SECTOR / 2)
+                     / ((long)HUE_SECTOR * HUE_SECTOR * HUE_SECTOR));
+}
+
+/**
+ * @brief 生成通道曲线 (编译期执行)：第一个色区上升，第二个色区下降，其余为 0。
+ */
+constexpr HueRamp make_hue_ramp() {
+    HueRamp ramp = {};
+    for (int x = 0; x < HUE_SECTOR; x++) {
+        ramp.level[x] = hue_rise(x);
+        ramp.level[HUE_SECTOR + x] = 255 - hue_rise(x);
+    }
+    return ramp;
+}
+
+static const HueRamp hue_ramp PROGMEM = make_hue_ramp();
+
+/**
+ * @brief 8 位缩放：a * (b + 1) / 256，b = 255 时保持不变。
+ */
+static inline uint8_t scale8(uint8_t a, uint8_t b) {
+    return (uint8_t)(((uint16_t)a * (b + 1)) >> 8);
+}
+
+/**
+ * @brief 在曲线的第 i 项和第 i-1 项之间按小数部分 frac/256 线性插值 (色轮方向取反，色相增大时 i 减小)。
+ */
+static inline uint8_t hue_ramp_lerp(uint8_t i, uint8_t frac) {
+    int a = pgm_read_byte(&hue_ramp.level[i]);
+    int b = pgm_read_byte(&hue_ramp.level[(uint8_t)(i - 1)]);
+    return (uint8_t)(a + (((b - a) * frac) >> 8));
+}
+
+/**
+ * @brief 全饱和度、全明度时的转换：整数色相只需三次查表，带小数时在相邻两项之间插值。
+ * @note 与 Wheel() 相同，色轮方向取反 (位置 0 为红，85 为绿，170 为蓝)。
+ */
+static inline uint32_t hue_to_grb(uint16_t hue) {
+    uint8_t q = 255 - (hue >> 8);
+    uint8_t frac = hue & 0xFF;
+    uint8_t r, g, b;
+    if (frac == 0) {
+        r = pgm_read_byte(&hue_ramp.level[(uint8_t)(q - 2 * HUE_SECTOR)]);
+        g = pgm_read_byte(&hue_ramp.level[(uint8_t)(q - HUE_SECTOR)]);
+        b = pgm_read_byte(&hue_ramp.level[q]);
+    } else {
+        r = hue_ramp_lerp(q - 2 * HUE_SECTOR, frac);
+        g = hue_ramp_lerp(q - HUE_SECTOR, frac);
+        b = hue_ramp_lerp(q, frac);
+    }
+    return ((uint32_t)g << 16) | ((uint32_t)r << 8) | b;
+}
+
+/**
+ * @brief 对一个纯色施加饱和度 (向白色混合) 和明度 (整体缩放)。
+ */
+static inline uint32_t apply_sat_val(uint32_t grb, uint8_t sat, uint8_t val) {
+    uint8_t white = 255 - sat;
+    uint8_t g = scale8(scale8(grb >> 16, sat) + white, val);
+    uint8_t r = scale8(scale8(grb >> 8, sat) + white, val);
+    uint8_t b = scale8(scale8(grb, sat) + white, val);
+    return ((uint32_t)g << 16) | ((uint32_t)r << 8) | b;
+}
+
+uint32_t hsv_to_grb(uint16_t hue, uint8_t sat, uint8_t val) {
+    uint32_t grb = hue_to_grb(hue);
+    if (sat == 255 && val == 255) return grb;
+    return apply_sat_val(grb, sat, val);
+}
+
+uint32_t hsv_wheel(uint8_t pos) {
+    return hue_to_grb((uint16_t)pos << 8);
+}
+
+/******************************************************************************
+ *                              批量填充
+ ******************************************************************************/
+
+void hsv_fill(SYC_WS2812& ws, uint8_t start, uint8_t count,
+              uint16_t hue, int16_t hue_step, uint8_t sat, uint8_t val) {
+    uint8_t end = start + count;
+    if (sat == 255 && val == 255) {
+        for (uint8_t i = start; i < end; i++, hue += hue_step) {
+            ws.setWs2812Color(i, hue_to_grb(hue));
+        }
+    } else {
+        for (uint8_t i = start; i < end; i++, hue += hue_step) {
+            ws.setWs2812Color(i, apply_sat_val(hue_to_grb(hue), sat, val));
+        }
+    }
+}
+
+void hsv_fill_frame(SYC_WS2812& ws, uint16_t hue, int16_t step_x, int16_t step_y,
+                    uint8_t sat, uint8_t val) {
+    for (uint8_t y = 0; y < 8; y++, hue += step_y) {
+        hsv_fill_row(ws, y, hue, step_x, sat, val);
+    }
+}
+
+void hsv_fill_mask(SYC_WS2812& ws, Bitboard mask,
+                   uint16_t hue, int16_t hue_step, uint8_t sat, uint8_t val) {
+    bool plain = (sat == 255 && val == 255);
+    // 只访问置位的像素，色相按像素编号直接算出
+    while (mask) {
+        uint8_t i = bb_pop_lsb(mask);
+        uint32_t grb = hue_to_grb(hue + (uint16_t)(i * hue_step));
+        ws.setWs2812Color(i, plain ? grb : apply_sat_val(grb, sat, val));
+    }
+}
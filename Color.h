@@ -0,0 +1,62 @@
+/**
+ * @file Color.h
+ * @author 多嘴龙虾
+ * @brief 定点 HSV 颜色引擎
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * 此头文件定义了 HSV 到 GRB 的定点转换接口，用于替代驱动库的 Wheel()。
+ * 色相使用 Q8.8 定点数 (高 8 位与 Wheel() 的位置含义相同，低 8 位为小数，在相邻两格之间插值)，
+ * 通道曲线由编译期生成的查找表提供，并支持饱和度和明度调节。
+ * 批量接口按色相增量连续填充一段、一帧或位棋盘选中的像素，
+ * 避免逐像素独立换算。
+ */
+
+#ifndef _COLOR_H_
+#define _COLOR_H_
+
+#include "Device.h"
+#include "Bitboard.h"
+
+/**
+ * @brief 将 HSV 转换为 GRB 颜色。
+ * @param hue 色相 (Q8.8，整圈为 0-65535；hue >> 8 与 Wheel() 的位置一致)。
+ * @param sat 饱和度 (0 为白色，255 为纯色)。
+ * @param val 明度 (0 为黑色，255 为最亮)。
+ * @return uint32_t GRB 颜色值。
+ */
+uint32_t hsv_to_grb(uint16_t hue, uint8_t sat, uint8_t val);
+
+/**
+ * @brief 全饱和度、全明度的色轮颜色，可直接替换 ws.Wheel(pos)。
+ */
+uint32_t hsv_wheel(uint8_t pos);
+
+/**
+ * @brief 从 start 开始连续填充 count 个像素，色相每个像素增加 hue_step。
+ */
+void hsv_fill(SYC_WS2812& ws, uint8_t start, uint8_t count,
+              uint16_t hue, int16_t hue_step, uint8_t sat, uint8_t val);
+
+/**
+ * @brief 填充第 y 行的 8 个像素。
+ */
+inline void hsv_fill_row(SYC_WS2812& ws, uint8_t y,
+                         uint16_t hue, int16_t hue_step, uint8_t sat, uint8_t val) {
+    hsv_fill(ws, y * 8, 8, hue, hue_step, sat, val);
+}
+
+/**
+ * @brief 填充整帧的二维渐变：像素 (x, y) 的色相为 hue + x * step_x + y * step_y。
+ */
+void hsv_fill_frame(SYC_WS2812& ws, uint16_t hue, int16_t step_x, int16_t step_y,
+                    uint8_t sat, uint8_t val);
+
+/**
+ * @brief 只填充位棋盘中置位的像素，像素 i 的色相为 hue + i * hue_step。
+ */
+void hsv_fill_mask(SYC_WS2812& ws, Bitboard mask,
+                   uint16_t hue, int16_t hue_step, uint8_t sat, uint8_t val);
+
+#endif
@@ -8,11 +8,12 @@
  *
  * 本文件包含了对项目硬件的具体驱动实现，包括：
  * - WS2812 彩灯的初始化与控制。
- * - 物理按键的事件处理，支持单击、长按和双击。
+ * - 物理按键的事件处理 (中断记录边沿，非阻塞消抖)，支持单击、双击、长按、自动重复、组合键和双键按下。
  * - 电源管理，包括电池电压读取和充电状态检测。
  */
 
 #include "Device.h"
+#include "Profiler.h"
 
 // 外部全局充电事件标志
 bool g_charging_started_event = false;
@@ -35,6 +36,81 @@ SYC_WS2812 strip = SYC_WS2812(ws2812_number, ws2812_brightness);
 void WS2812_Init()
 {
   strip.setup();
+  Ws2812_invalidate();
+}
+
+// 上一次实际发送到灯珠的帧内容及亮度
+static uint32_t last_sent_frame[ws2812_number];
+static uint8_t last_sent_brightness = 0;
+// 为 false 时，下一帧无论内容如何都要整帧发送
+static bool last_sent_valid = false;
+
+// 按主模式分类的统计 (包含 SYSTEM_OVERLAY)
+static ShowStats show_stats[(int)MainMode::SYSTEM_OVERLAY + 1];
+
+/**
+ * @brief 帧差分发送。
+ * @details 从后往前找到第一个与上一帧不同的像素，得到本帧需要发送的长度：
+ *          - 长度为0 (且亮度未变)：跳过 Ws2812_show()，这是静态画面(图片、字母、电量)的常态。
+ *          - 只有前面部分像素变化：只需发送到最高变化索引为止，后面的灯珠保持原样。
+ *          亮度变化会影响所有像素，因此按整帧发送处理。
+ */
+void Ws2812_present(uint8_t brightness, MainMode mode) {
+    ShowStats& stats = show_stats[(int)mode];
+    stats.frames++;
+
+    int dirty_len = ws2812_number;
+    if (last_sent_valid && brightness == last_sent_brightness) {
+        while (dirty_len > 0 && strip.led_data[dirty_len - 1] == last_sent_frame[dirty_len - 1]) {
+            dirty_len--;
+        }
+    }
+
+    if (dirty_len == 0) {
+        stats.skipped++;
+        return;
+    }
+
+    // 只拷贝变化的前缀，后面的像素与影子帧相同
+    for (int i = 0; i < dirty_len; i++) {
+        last_sent_frame[i] = strip.led_data[i];
+    }
+    last_sent_brightness = brightness;
+    last_sent_valid = true;
+    stats.pixels_sent += dirty_len;
+
+    PROFILE_BEGIN(present_t0);
+    strip.setBrightness(brightness);
+#if WS2812_PARTIAL_SHOW
+    strip.Ws2812_show(dirty_len);
+#else
+    strip.Ws2812_show();
+#endif
+    PROFILE_END(present_t0, PROF_STAGE_PRESENT);
+}
+
+/**
+ * @brief 使影子帧失效，强制下一帧整帧发送。
+ * @details 在绕过 Ws2812_present() 直接操作灯珠后调用，保证影子帧与灯珠实际状态一致。
+ */
+void Ws2812_invalidate() {
+    last_sent_valid = false;
+}
+
+/**
+ * @brief 获取指定主模式的帧差分统计数据。
+ */
+const ShowStats& getShowStats(MainMode mode) {
+    return show_stats[(int)mode];
+}
+
+/**
+ * @brief 清零所有模式的帧差分统计数据。
+ */
+void resetShowStats() {
+    for (int i = 0; i <= (int)MainMode::SYSTEM_OVERLAY; i++) {
+        show_stats[i] = {0, 0, 0};
+    }
 }
 /***************************************************************************/
 
@@ -42,94 +118,280 @@ void WS2812_Init()
  *                            按键驱动 (Key Driver)
  ******************************************************************************/
 
-// 记录按键被按下的起始时间
-static unsigned long left_key_down_time = 0;
-static unsigned long right_key_down_time = 0;
+/*
+ * 按键由引脚中断驱动，分为两层：
+ * - 中断 (生产者)：任一按键引脚电平变化时，记录时间戳和两个按键的电平，写入边沿队列。
+ * - read_key_event() (消费者)：在主循环中取出边沿，完成消抖，再由手势识别把稳定的
+ *   按键状态变化分类为单击、双击、长按、自动重复、组合键、双键按下和松开，
+ *   放入事件队列后逐个返回。
+ * 队列只有一个生产者和一个消费者，各自只写自己的下标，因此无需关中断。
+ * 两层都不阻塞：按住按键时动画照常运行，没有按键活动时 read_key_event() 几乎不占时间。
+ */
+
+// 按键位 (与边沿中记录的电平位一致)
+const uint8_t KEY_LEFT_BIT  = 0x01;
+const uint8_t KEY_RIGHT_BIT = 0x02;
+const uint8_t KEY_BOTH_BITS = KEY_LEFT_BIT | KEY_RIGHT_BIT;
+
+// 在松开时才报告长按的按键：右键是“按住右键、单击左键”(上一项) 的修饰键，
+// 按住右键多久都还可能组成组合键，长按 (返回) 等到松开且期间没有组合键时才产生，也不自动重复
+const uint8_t KEY_LONG_ON_RELEASE = KEY_RIGHT_BIT;
+
+/**
+ * @brief 一次引脚电平变化。
+ */
+struct KeyEdge {
+    uint16_t time; // 发生时刻 (millis() 的低16位，按差值使用，回绕无影响)
+    uint8_t keys;  // 变化后按下的按键 (KEY_*_BIT)
+};
+
+// ---- 边沿队列 (中断 -> 主循环) ----
+static volatile KeyEdge key_edges[KEY_EDGE_QUEUE_SIZE];
+static volatile uint8_t key_edge_head = 0;     // 只由中断写
+static volatile uint8_t key_edge_tail = 0;     // 只由 read_key_event() 写
+static volatile bool key_edge_overflow = false; // 队列满时丢弃边沿并置位，由消费者重新同步
+
+static_assert((KEY_EDGE_QUEUE_SIZE & (KEY_EDGE_QUEUE_SIZE - 1)) == 0, "KEY_EDGE_QUEUE_SIZE 必须是2的幂");
+
+// ---- 消抖 ----
+static uint8_t key_raw = 0;       // 最近一次边沿后的电平
+static uint16_t key_raw_time = 0; // 最近一次边沿的时刻
+static uint8_t key_stable = 0;    // 消抖后的按键状态
+
+// ---- 手势识别 (数组下标 0 为左键、1 为右键) ----
+static KeyTimings key_timings = KEY_TIMINGS_DEFAULT;
+static uint16_t key_down_time[2];       // 稳定按下的时刻
+static uint16_t key_release_time[2];    // 上一次单击松开的时刻
+static uint16_t key_repeat_next[2];     // 下一次自动重复的时刻
+static uint16_t key_repeat_interval[2]; // 当前的重复间隔
+static uint8_t key_long_fired = 0;      // 本次按下已触发长按的按键
+static uint8_t key_consumed = 0;        // 已属于双键按下或组合键，不再产生单击、长按和重复的按键
+static uint8_t key_chord = 0;           // 在另一键按住时按下的按键，松开时产生组合键事件
+static uint8_t key_click_pending = 0;   // 上一次是单击、可能与下一次单击组成双击的按键
+
+// ---- 事件队列 (识别结果，一次处理可能产生多个事件) ----
+static KeyEvent key_events[KEY_EVENT_QUEUE_SIZE];
+static uint8_t key_event_head = 0;
+static uint8_t key_event_count = 0;
+static uint16_t key_event_drops = 0; // 队列满而丢弃的事件数
+
+static inline uint8_t read_key_pins() {
+    uint8_t keys = 0;
+    if (!digitalRead(LEFT_KEY_PIN))  keys |= KEY_LEFT_BIT;
+    if (!digitalRead(RIGHT_KEY_PIN)) keys |= KEY_RIGHT_BIT;
+    return keys;
+}
+
+/**
+ * @brief 按键引脚中断：记录边沿。两个引脚共用，每次都记录两个按键的电平。
+ */
+static void key_isr() {
+    uint8_t head = key_edge_head;
+    uint8_t next = (head + 1) & (KEY_EDGE_QUEUE_SIZE - 1);
+    if (next == key_edge_tail) {
+        key_edge_overflow = true;
+        return;
+    }
+    key_edges[head].time = (uint16_t)millis();
+    key_edges[head].keys = read_key_pins();
+    key_edge_head = next; // 最后发布下标，消费者看到新下标时数据已写好
+}
+
+static void push_key_event(KeyEvent event) {
+    // 自动重复只表示“继续按住”：上一个同样的重复还没被取走时合并为一个
+    bool repeat = event == KeyEvent::LEFT_REPEAT || event == KeyEvent::RIGHT_REPEAT;
+    if (repeat && key_event_count > 0 &&
+        key_events[(key_event_head + key_event_count - 1) % KEY_EVENT_QUEUE_SIZE] == event) {
+        return;
+    }
+    if (key_event_count == KEY_EVENT_QUEUE_SIZE) {
+        key_event_drops++; // 主循环停顿过久，记录下来而不是静默丢弃
+        return;
+    }
+    key_events[(key_event_head + key_event_count) % KEY_EVENT_QUEUE_SIZE] = event;
+    key_event_count++;
+}
+
+// 每个按键对应的事件，按下标 0 (左)、1 (右) 排列
+static const KeyEvent KEY_CLICK_EVENT[2]        = {KeyEvent::LEFT_CLICK, KeyEvent::RIGHT_CLICK};
+static const KeyEvent KEY_DOUBLE_CLICK_EVENT[2] = {KeyEvent::LEFT_DOUBLE_CLICK, KeyEvent::RIGHT_DOUBLE_CLICK};
+static const KeyEvent KEY_LONG_PRESS_EVENT[2]   = {KeyEvent::LEFT_LONG_PRESS, KeyEvent::RIGHT_LONG_PRESS};
+static const KeyEvent KEY_REPEAT_EVENT[2]       = {KeyEvent::LEFT_REPEAT, KeyEvent::RIGHT_REPEAT};
+static const KeyEvent KEY_RELEASE_EVENT[2]      = {KeyEvent::LEFT_RELEASE, KeyEvent::RIGHT_RELEASE};
+// 组合键以松开的 (被单击的) 按键为下标
+static const KeyEvent KEY_CHORD_EVENT[2]        = {KeyEvent::RIGHT_HOLD_LEFT_CLICK, KeyEvent::LEFT_HOLD_RIGHT_CLICK};
 
-// 标记长按事件是否已经触发过，以防止在一次长按中重复触发事件
-static bool left_key_long_press_fired = false;
-static bool right_key_long_press_fired = false;
+/**
+ * @brief 一个按键稳定地松开：依次产生单击 (及双击) 或组合键，最后是松开事件。
+ */
+static void key_released(uint8_t k, uint16_t time) {
+    uint8_t bit = 1 << k;
+    if (key_chord & bit) {
+        key_chord &= ~bit;
+        push_key_event(KEY_CHORD_EVENT[k]);
+    } else if ((key_long_fired & KEY_LONG_ON_RELEASE & bit) && !(key_consumed & bit)) {
+        push_key_event(KEY_LONG_PRESS_EVENT[k]); // 按住期间没有组成组合键，松开时才是长按
+    } else if (!((key_long_fired | key_consumed) & bit)) {
+        push_key_event(KEY_CLICK_EVENT[k]);
+        // 上一次单击松开后不久再次按下：第二次单击之后紧跟双击，随后重新开始计数
+        if ((key_click_pending & bit) && (uint16_t)(key_down_time[k] - key_release_time[k]) <= key_timings.double_click) {
+            push_key_event(KEY_DOUBLE_CLICK_EVENT[k]);
+            key_click_pending &= ~bit;
+        } else {
+            key_click_pending |= bit;
+            key_release_time[k] = time;
+        }
+    }
+    push_key_event(KEY_RELEASE_EVENT[k]);
+}
+
+/**
+ * @brief 一个按键稳定地按下：另一键已按住时，判断是双键按下还是组合键。
+ * @param held 此前已按住的按键。
+ */
+static void key_pressed(uint8_t k, uint16_t time, uint8_t held) {
+    uint8_t bit = 1 << k;
+    uint8_t other = bit ^ KEY_BOTH_BITS;
+    key_down_time[k] = time;
+    key_long_fired &= ~bit;
+    key_consumed &= ~bit;
+    // 另一键本身是组合键中被单击的键时 (按住它再按本键)，不再嵌套组合
+    if (!(held & other) || (key_chord & other)) return;
+
+    // 两键都参与了手势：都不再产生单击、长按和重复，也不会与之后的单击组成双击；
+    // 按住的键可以连续单击另一键，每次都是组合键
+    key_consumed = KEY_BOTH_BITS;
+    key_click_pending = 0;
+    if ((uint16_t)(time - key_down_time[1 - k]) < key_timings.chord_window) {
+        push_key_event(KeyEvent::BOTH_PRESS);
+    } else {
+        key_chord |= bit;
+    }
+}
+
+/**
+ * @brief 稳定的按键状态发生变化：先处理松开，再处理按下。
+ * @param keys 新的稳定状态。
+ * @param time 状态开始的时刻。
+ */
+static void key_state_changed(uint8_t keys, uint16_t time) {
+    uint8_t pressed  = keys & ~key_stable;
+    uint8_t released = key_stable & ~keys;
+    uint8_t held = key_stable & keys;
+    key_stable = keys;
+
+    for (uint8_t k = 0; k < 2; k++) {
+        if (released & (1 << k)) key_released(k, time);
+    }
+    for (uint8_t k = 0; k < 2; k++) {
+        if (pressed & (1 << k)) {
+            key_pressed(k, time, held);
+            held |= 1 << k;
+        }
+    }
+}
 
 /**
  * @brief 初始化按键所需的GPIO引脚。
  * @details 将按键引脚设置为上拉输入模式。当按键按下时，引脚电平为低。
+ *          两个引脚的电平变化都会触发中断。
  */
 void Key_Init() {
     pinMode(LEFT_KEY_PIN, INPUT_PULLUP);
     pinMode(RIGHT_KEY_PIN, INPUT_PULLUP);
+    // 上电时已按下的按键同样需要经过消抖
+    key_raw = read_key_pins();
+    key_raw_time = (uint16_t)millis();
+    attachInterrupt(digitalPinToInterrupt(LEFT_KEY_PIN), key_isr, CHANGE);
+    attachInterrupt(digitalPinToInterrupt(RIGHT_KEY_PIN), key_isr, CHANGE);
+}
+
+bool key_edge_pending() {
+    return key_edge_tail != key_edge_head || key_edge_overflow;
+}
+
+bool key_all_released() {
+    return !key_edge_pending() && key_stable == 0 && key_raw == 0;
+}
+
+void key_set_timings(const KeyTimings& timings) {
+    key_timings = timings;
+}
+
+const KeyTimings& key_get_timings() {
+    return key_timings;
+}
+
+uint16_t key_event_dropped() {
+    return key_event_drops;
 }
 
 /**
  * @brief 读取并返回当前的按键事件。
- * @details 这是一个非阻塞的状态机函数，可在主循环中被频繁调用。
- *          它能有效地处理按键抖动，并识别单击、长按和双键齐按事件。
+ * @details 非阻塞：取出中断记录的边沿完成消抖和分类，每次调用返回一个事件。
+ *          边沿和事件队列都为空且没有按键按住时立即返回。
  * @return KeyEvent枚举，表示当前检测到的按键事件。如果没有事件，则返回 NO_EVENT。
  */
 KeyEvent read_key_event() {
-    // 读取当前按键的物理状态 (低电平为按下)
-    bool left_key_pressed = !digitalRead(LEFT_KEY_PIN);
-    bool right_key_pressed = !digitalRead(RIGHT_KEY_PIN);
-
-    // ----- 1. 优先处理双键同时按下的情况 -----
-    // 当检测到两个键都按下时，立即处理并返回，以防止被后续逻辑误判为单击或长按。
-    if (left_key_pressed && right_key_pressed) {
-        // 消抖
-        delay(DEBOUNCE_TIME);
-        // 再次确认是否双键按下
-        if (!digitalRead(LEFT_KEY_PIN) && !digitalRead(RIGHT_KEY_PIN)) {
-            // 等待按键被释放。
-            while(!digitalRead(LEFT_KEY_PIN) && !digitalRead(RIGHT_KEY_PIN)) {
-                yield(); // 继续处理其他任务
-            }
-            return KeyEvent::BOTH_PRESS; // 双键按下
-        }
-    }
+    bool idle = key_edge_tail == key_edge_head && key_event_count == 0 &&
+                key_raw == key_stable && key_stable == 0;
+    if (idle && !key_edge_overflow) return KeyEvent::NO_EVENT;
 
-    // ----- 2. 处理左键 -----
-    if (left_key_pressed) {
-        // 如果 left_key_down_time 为0，说明按键刚被按下
-        if (left_key_down_time == 0) {
-            left_key_down_time = millis();     // 记录按键按下的时间戳
-            left_key_long_press_fired = false; // 重置长按触发标志
-        } else if (!left_key_long_press_fired && (millis() - left_key_down_time > LONG_PRESS_TIME)) {
-            // 如果按键持续按下超过了设定的长按时间，并且长按事件还未触发过
-            left_key_long_press_fired = true;  // 长按触发
-            return KeyEvent::LEFT_LONG_PRESS;    // 左键长按
-        }
-    } else { // 左键释放
-        // 如果 left_key_down_time 大于0，说明按键刚被释放
-        if (left_key_down_time > 0) {
-            // 检查按下持续时间：必须大于消抖时间，且长按事件未被触发
-            if (!left_key_long_press_fired && (millis() - left_key_down_time > DEBOUNCE_TIME)) {
-                left_key_down_time = 0;      // 重置时间
-                return KeyEvent::LEFT_CLICK; // 左键单击
-            }
-            // 长按释放
-            left_key_down_time = 0;
+    uint16_t now = (uint16_t)millis();
+
+    // ----- 1. 边沿消抖 -----
+    // 电平保持 debounce 时间不再变化才被采纳，期间的抖动只会重新开始计时
+    if (key_edge_overflow) {
+        // 边沿丢失：清空队列，直接以当前电平重新开始消抖
+        key_edge_tail = key_edge_head;
+        key_edge_overflow = false;
+        key_raw = read_key_pins();
+        key_raw_time = now;
+    }
+    while (key_edge_tail != key_edge_head) {
+        uint8_t tail = key_edge_tail;
+        uint16_t time = key_edges[tail].time;
+        uint8_t keys = key_edges[tail].keys;
+        key_edge_tail = (tail + 1) & (KEY_EDGE_QUEUE_SIZE - 1);
+        // 主循环来不及处理时队列中可能积压了完整的按下、松开过程，按边沿的时刻逐个判断
+        if (key_raw != key_stable && (uint16_t)(time - key_raw_time) >= key_timings.debounce) {
+            key_state_changed(key_raw, key_raw_time);
         }
+        key_raw = keys;
+        key_raw_time = time;
+    }
+    if (key_raw != key_stable && (uint16_t)(now - key_raw_time) >= key_timings.debounce) {
+        key_state_changed(key_raw, key_raw_time);
     }
 
-    // ----- 3. 处理右键（逻辑与左键相同） -----
-    if (right_key_pressed) {
-        if (right_key_down_time == 0) {
-            right_key_down_time = millis();
-            right_key_long_press_fired = false;
-        } else if (!right_key_long_press_fired && (millis() - right_key_down_time > LONG_PRESS_TIME)) {
-            right_key_long_press_fired = true;
-            return KeyEvent::RIGHT_LONG_PRESS;
-        }
-    } else {
-        if (right_key_down_time > 0) {
-            if (!right_key_long_press_fired && (millis() - right_key_down_time > DEBOUNCE_TIME)) {
-                right_key_down_time = 0;
-                return KeyEvent::RIGHT_CLICK;
+    // ----- 2. 长按触发一次，之后继续按住则按逐渐缩短的间隔自动重复 -----
+    for (uint8_t k = 0; k < 2; k++) {
+        uint8_t bit = 1 << k;
+        if (!(key_stable & bit) || (key_consumed & bit)) continue;
+        if (!(key_long_fired & bit)) {
+            if ((uint16_t)(now - key_down_time[k]) > key_timings.long_press) {
+                key_long_fired |= bit;
+                key_click_pending &= ~bit;
+                if (KEY_LONG_ON_RELEASE & bit) continue; // 只记下已是长按，松开时再报告
+                key_repeat_interval[k] = key_timings.repeat_start;
+                key_repeat_next[k] = now + key_repeat_interval[k];
+                push_key_event(KEY_LONG_PRESS_EVENT[k]);
             }
-            right_key_down_time = 0;
+        } else if (!(KEY_LONG_ON_RELEASE & bit) && (int16_t)(now - key_repeat_next[k]) >= 0) {
+            uint16_t interval = key_repeat_interval[k] - key_repeat_interval[k] / 4;
+            key_repeat_interval[k] = interval > key_timings.repeat_min ? interval : key_timings.repeat_min;
+            // 从当前时刻计算下一次，主循环停顿后不会连续补发
+            key_repeat_next[k] = now + key_repeat_interval[k];
+            push_key_event(KEY_REPEAT_EVENT[k]);
         }
     }
 
-    // 无按键按下
-    return KeyEvent::NO_EVENT;
+    // ----- 3. 每次返回一个事件 -----
+    if (key_event_count == 0) return KeyEvent::NO_EVENT;
+    KeyEvent event = key_events[key_event_head];
+    key_event_head = (key_event_head + 1) % KEY_EVENT_QUEUE_SIZE;
+    key_event_count--;
+    return event;
 }
 /***************************************************************************/
 
@@ -140,8 +402,6 @@ KeyEvent read_key_event() {
 static BatteryLevel g_current_level = LEVEL_FULL;
 // 保存当前充电状态
 static ChargingState g_charging_state = STATE_DISCHARGING;
-// 记录上次检查电压的时间
-static unsigned long g_last_voltage_check_time = 0;
 
 /**
  * @brief 初始化电源管理模块相关的引脚
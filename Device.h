@@ -40,10 +40,50 @@ const int ws2812_number = 64;
  */
 const int ws2812_brightness = 80;
 
+/**
+ * @brief 驱动是否支持只发送前 N 个灯珠的截断发送 (`Ws2812_show(count)`)。
+ * @note WS2812 级联时，只发送前 N 个像素后，其余灯珠会保持原来的颜色。
+ *       当前驱动库只提供整帧发送，因此默认关闭，只在统计中记录截断后的像素数。
+ */
+#ifndef WS2812_PARTIAL_SHOW
+#define WS2812_PARTIAL_SHOW 0
+#endif
+
+/**
+ * @brief 帧差分发送的统计数据 (按主模式分类)。
+ */
+struct ShowStats {
+    uint32_t frames;      // 提交的总帧数
+    uint32_t skipped;     // 画面无变化而跳过发送的帧数
+    uint32_t pixels_sent; // 需要发送的像素总数 (截断到最高变化索引)
+};
+
 /**
  * @brief 初始化WS2812 LED灯条。
  */
 void WS2812_Init();
+
+/**
+ * @brief 将 strip.led_data 与上一次发送的帧进行比较，只在画面变化时才发送。
+ * @param brightness 本帧使用的亮度 (0-255)，亮度变化也视为画面变化。
+ * @param mode 本帧所属的主模式，用于分类统计。
+ */
+void Ws2812_present(uint8_t brightness, MainMode mode);
+
+/**
+ * @brief 使上一次发送的帧失效，强制下一次 Ws2812_present() 发送整帧。
+ */
+void Ws2812_invalidate(void);
+
+/**
+ * @brief 获取指定主模式的帧差分统计数据。
+ */
+const ShowStats& getShowStats(MainMode mode);
+
+/**
+ * @brief 清零所有模式的帧差分统计数据。
+ */
+void resetShowStats(void);
 /***************************************************************************/
 
 
@@ -64,23 +104,74 @@ const int RIGHT_KEY_PIN = PA1;
 
 // --- 按键时序参数配置 ---
 /**
- * @brief 按键消抖时间 (单位: 毫秒)。在此时间内的电平变化被视作抖动。
+ * @brief 手势识别的时序参数 (单位: 毫秒)，可在运行时通过 key_set_timings() 修改。
  */
-const unsigned long DEBOUNCE_TIME = 20;
+struct KeyTimings {
+    uint16_t debounce;      // 消抖：电平保持这么久不变才被采纳
+    uint16_t long_press;    // 按住超过这个时间判定为长按 (右键在松开时报告，按住期间仍可组成组合键)
+    uint16_t double_click;  // 松开后在这个时间内再次按下，第二次单击之后产生双击
+    uint16_t chord_window;  // 两键按下的间隔小于它为双键按下，否则为“按住一键、单击另一键”的组合键
+    uint16_t repeat_start;  // 长按后第一次重复的间隔
+    uint16_t repeat_min;    // 重复间隔每次缩短 1/4，直到这个下限
+};
 
 /**
- * @brief 判定为长按所需的最短持续时间 (单位: 毫秒)。
+ * @brief 默认的按键时序。
  */
-const unsigned long LONG_PRESS_TIME = 800;
+const KeyTimings KEY_TIMINGS_DEFAULT = {
+    20,  // debounce
+    800, // long_press
+    300, // double_click
+    100, // chord_window
+    250, // repeat_start
+    60,  // repeat_min
+};
+
+/**
+ * @brief 按键边沿队列的容量 (必须是2的幂)，中断记录的边沿在此等待主循环处理。
+ * @note 可容纳主循环一次较长的停顿中产生的抖动和按键动作；溢出时按当前电平重新同步。
+ */
+const uint8_t KEY_EDGE_QUEUE_SIZE = 16;
+
+/**
+ * @brief 按键事件队列的容量。两个按键同时松开时最多产生 6 个事件 (单击、双击、松开各两个)。
+ * @note 未取走的同一个自动重复事件会合并；队列满时丢弃新事件并计数 (key_event_dropped())。
+ */
+const uint8_t KEY_EVENT_QUEUE_SIZE = 8;
 
 // --- 按键驱动函数声明 ---
 /**
- * @brief 初始化按键所需的GPIO引脚。
+ * @brief 初始化按键所需的GPIO引脚，并注册电平变化中断。
  */
 void Key_Init(void);
 
 /**
- * @brief 读取并返回当前的按键事件。
+ * @brief 是否有中断记录、尚未处理的按键边沿 (用于提前结束空闲和判断唤醒来源)。
+ */
+bool key_edge_pending(void);
+
+/**
+ * @brief 所有按键都已稳定松开，且没有待处理的边沿。
+ */
+bool key_all_released(void);
+
+/**
+ * @brief 设置手势识别的时序参数。
+ */
+void key_set_timings(const KeyTimings& timings);
+
+/**
+ * @brief 获取当前的手势识别时序参数。
+ */
+const KeyTimings& key_get_timings(void);
+
+/**
+ * @brief 获取因事件队列已满而丢弃的按键事件数。
+ */
+uint16_t key_event_dropped(void);
+
+/**
+ * @brief 读取并返回当前的按键事件 (非阻塞，处理中断记录的按键边沿并识别手势)。
  * @return KeyEvent 枚举值，表示检测到的事件（如单击、长按等）。
  */
 KeyEvent read_key_event(void);
@@ -11,43 +11,68 @@
  * - 康威生命游戏 (Conway's Game of Life)
  * - 贪吃蛇 (Snake)
  * 并为每个游戏提供了初始化、输入处理、逻辑更新和屏幕渲染的函数。
- * 文件末尾还提供了统一的游戏管理接口。
+ * 各游戏的工作状态在进入模式时从模式内存池 (Mode.h) 申请，离开模式时整体释放，
+ * 只有当前模式的状态占用内存。游戏的调度由模式注册表 (Mode.cpp) 完成。
  */
 
 #include "Game.h"
+#include "Mode.h"
 
 /******************************************************************************
  *                            弹珠游戏 (Pinball)
  ******************************************************************************/
 
-// 弹珠游戏的状态枚举
-enum PinballState {
-    PINBALL_RUNNING,    // 游戏运行中
-    PINBALL_GAME_OVER   // 游戏结束
-};
-// 静态变量，保存当前弹珠游戏的状态
-static PinballState pinball_state;
+// 弹珠游戏 (及其菜单动态LOGO) 的工作状态，进入模式时从模式内存池申请，字段见 PinballData。
+// 小球的位置和速度都是 Q8.8 定点数：位置单位为像素 (256 = 1 像素，像素中心在整数处)，
+// 速度单位为 像素/物理步。物理以固定步长推进，与渲染帧率无关。
+static PinballData* pinball;
 
 // --- 游戏对象 ---
-static int ball_x, ball_y;         // 小球的坐标 (x, y)
-static int vel_x, vel_y;           // 小球的速度向量 (x方向速度, y方向速度)
-static int paddle_pos;             // 挡板的左端x坐标
 const int PADDLE_LEN = 3;          // 挡板的长度（3个像素）
 
-// --- 用于动态LOGO的游戏对象  ---
-static int logo_ball_x, logo_ball_y;        // LOGO小球坐标
-static int logo_vel_x, logo_vel_y;          // LOGO小球速度
-static int logo_paddle_pos;                 // LOGO挡板位置
-static unsigned long logo_last_update_time; // LOGO上次更新时间
-static bool logo_is_initialized = false;    // LOGO动画状态
+// --- 物理参数 ---
+const uint8_t PINBALL_STEP_MS = 16;       // 物理步长 (ms)，约 62.5 步/秒
+const uint8_t PINBALL_MAX_STEPS = 8;      // 一帧最多追赶的物理步数，卡顿后不会一次跳太远
+#define PINBALL_PX_PER_S(v) ((int16_t)((v) * 256L * PINBALL_STEP_MS / 1000)) // 像素/秒 → Q8.8 像素/步
+const int16_t PINBALL_SPEED_START = PINBALL_PX_PER_S(5);  // 初始速率 5 像素/秒
+const int16_t PINBALL_SPEED_MAX   = PINBALL_PX_PER_S(20); // 最高速率 20 像素/秒
+const int16_t PINBALL_MAX_POS = (BOARD_WIDTH - 1) * 256;  // 小球中心的最大坐标 (Q8.8)
+const int16_t PINBALL_PADDLE_Y = (BOARD_HEIGHT - 2) * 256; // 小球中心到达这一行时与挡板接触
+
+/**
+ * @brief 挡板反弹方向表：按击中位置从挡板左端到右端，反弹角为 -60° 到 60° (0° 为竖直向上)。
+ * @details 每项为 {sin, cos} * 256。
+ */
+static const int16_t pinball_bounce_dir[9][2] PROGMEM = {
+    {-222, 128}, {-181, 181}, {-128, 222}, {-66, 247}, {0, 256},
+    {  66, 247}, { 128, 222}, { 181, 181}, {222, 128},
+};
+
+// --- 打砖块模式 ---
+// 砖块的剩余耐久 (0-3) 按位切片存成两个位棋盘：耐久 = lo + 2 * hi，lo | hi 即所有砖块。
+// 碰撞只需测试小球所在格子的一位，与剩余砖块的数量无关。
+static bool pinball_breakout = false;  // true: 打砖块模式 (设置，不随模式切换清除)
+const unsigned long PINBALL_LEVEL_PAUSE = 1200; // 过关后的停顿时间 (ms)
 
-// --- 游戏通用参数 ---
-static unsigned long game_time;     // 记录上一帧的时间，用于控制更新速率
-static int game_speed;              // 游戏速度 (帧更新间隔，单位ms，值越小越快)
-static uint8_t rainbow_hue = 0;     // 生成彩虹色，随时间变化
+/**
+ * @brief 打砖块关卡：两个耐久位平面 (第 i 位为 i 号格子)。
+ */
+struct BrickLevel {
+    Bitboard lo;
+    Bitboard hi;
+};
+
+// 砖块占据上面三行，第 3-6 行留给小球活动
+static const BrickLevel brick_levels[] PROGMEM = {
+    {0x000000000000FFFFULL, 0x0000000000000000ULL}, // 两行耐久 1
+    {0x0000000000FFFF00ULL, 0x00000000000000FFULL}, // 顶行耐久 2，下面两行耐久 1
+    {0x00000000003CAAFFULL, 0x00000000000055FFULL}, // 顶行耐久 3，第二行 2/1 交错，第三行中间 1
+    {0x0000000000C3E7FFULL, 0x00000000003C18FFULL}, // 顶行耐久 3，下面两行中间一块耐久 2 的“盾”，两侧耐久 1
+};
+const uint8_t BRICK_LEVEL_COUNT = sizeof(brick_levels) / sizeof(brick_levels[0]);
 
-// --- Game Over 状态计时 ---
-static unsigned long game_over_time; // 记录进入Game Over状态的时刻
+// 各耐久对应的色相：1 绿、2 黄、3 红
+static const uint8_t brick_hue[4] PROGMEM = {0, 85, 42, 0};
 
 /**
  * @brief (弹珠游戏辅助函数) 将二维坐标(x, y)转换为一维的LED索引。
@@ -63,18 +88,55 @@ static int pos2index(int x, int y) {
     return y * BOARD_WIDTH + x;
 }
 
+/**
+ * @brief 载入打砖块的当前关卡，小球从挡板上方斜向上发出。
+ */
+static void pinball_load_level() {
+    BrickLevel level;
+    memcpy_P(&level, &brick_levels[pinball->brick_level % BRICK_LEVEL_COUNT], sizeof(level));
+    pinball->brick_lo = level.lo;
+    pinball->brick_hi = level.hi;
+    pinball->ball_x = (pinball->paddle_pos + PADDLE_LEN / 2) * 256;
+    pinball->ball_y = PINBALL_PADDLE_Y;
+    // 每通过一轮全部关卡，初始速率提高一档
+    pinball->ball_speed = PINBALL_SPEED_START + (pinball->brick_level / BRICK_LEVEL_COUNT) * PINBALL_PX_PER_S(2);
+    if (pinball->ball_speed > PINBALL_SPEED_MAX) pinball->ball_speed = PINBALL_SPEED_MAX;
+    pinball->vel_x = pinball->ball_speed * 181 / 256;  // 右上 45°
+    pinball->vel_y = -pinball->ball_speed * 181 / 256;
+}
+
 /**
  * @brief 初始化或重置弹珠游戏的状态。
  */
 void pinball_init() {
-    ball_x = 2;                      // 小球初始横坐标
-    ball_y = 2;                      // 小球初始纵坐标
-    vel_x = 1;                       // x方向初始速度
-    vel_y = 1;                       // y方向初始速度
-    paddle_pos = 2;                  // 挡板初始位置
-    game_speed = 300;                // 初始游戏速度
-    pinball_state = PINBALL_RUNNING; // 设置游戏状态为运行中
-    game_time = millis();            // 初始化游戏计时器
+    pinball->ball_x = 2 * 256;                // 小球初始横坐标
+    pinball->ball_y = 2 * 256;                // 小球初始纵坐标
+    pinball->ball_speed = PINBALL_SPEED_START;
+    pinball->vel_x = pinball->ball_speed * 181 / 256;  // 初始方向：右下 45°
+    pinball->vel_y = pinball->ball_speed * 181 / 256;
+    pinball->paddle_pos = 2;                  // 挡板初始位置
+    pinball->state = PINBALL_RUNNING; // 设置游戏状态为运行中
+    pinball->game_time = millis();            // 初始化游戏计时器
+    pinball->accum_ms = 0;
+    pinball->brick_lo = pinball->brick_hi = BB_EMPTY;
+    if (pinball_breakout) {
+        pinball->brick_level = 0;
+        pinball_load_level();
+    }
+}
+
+void pinball_enter() {
+    pinball = mode_claim<PinballData>();
+    pinball_init();
+}
+
+void pinball_set_breakout(bool on) {
+    pinball_breakout = on;
+    pinball_init();
+}
+
+bool pinball_get_breakout() {
+    return pinball_breakout;
 }
 
 /**
@@ -82,8 +144,13 @@ void pinball_init() {
  * @param event 传入的按键事件。
  */
 void pinball_handle_input(KeyEvent event) {
+    // 左键长按：在弹珠与打砖块之间切换，并重新开始
+    if (event == KeyEvent::LEFT_LONG_PRESS) {
+        pinball_set_breakout(!pinball_breakout);
+        return;
+    }
     // 如果当前是 "Game Over" 状态
-    if (pinball_state == PINBALL_GAME_OVER) {
+    if (pinball->state == PINBALL_GAME_OVER) {
         // 任意单击事件都会重新开始游戏
         if (event == KeyEvent::LEFT_CLICK || event == KeyEvent::RIGHT_CLICK) {
             pinball_init(); // 重新初始化
@@ -93,66 +160,188 @@ void pinball_handle_input(KeyEvent event) {
 
     // 控制挡板移动
     if (event == KeyEvent::LEFT_CLICK) {
-        paddle_pos--; // 左键，挡板左移
+        pinball->paddle_pos--; // 左键，挡板左移
     }
     else if (event == KeyEvent::RIGHT_CLICK) {
-        paddle_pos++; // 右键，挡板右移
+        pinball->paddle_pos++; // 右键，挡板右移
     }
     // 确保挡板不会移出屏幕边界
-    paddle_pos = constrain(paddle_pos, 0, BOARD_WIDTH - PADDLE_LEN);
+    pinball->paddle_pos = constrain(pinball->paddle_pos, 0, BOARD_WIDTH - PADDLE_LEN);
+}
+
+/**
+ * @brief 小球在 [0, PINBALL_MAX_POS] 的边界上镜面反弹。
+ * @return 发生反弹时返回 true。
+ */
+static bool pinball_reflect(int16_t& pos, int16_t& vel, int16_t lo, int16_t hi) {
+    if (pos < lo) { pos = 2 * lo - pos; vel = -vel; return true; }
+    if (pos > hi) { pos = 2 * hi - pos; vel = -vel; return true; }
+    return false;
+}
+
+/**
+ * @brief 击中 mask 所在的砖块：耐久减一 (位切片减法：3→2、2→1、1→0)。
+ */
+static void pinball_damage_brick(Bitboard mask) {
+    if (pinball->brick_lo & mask) {
+        pinball->brick_lo ^= mask;  // 3→2 或 1→0
+    } else {
+        pinball->brick_hi ^= mask;  // 2→1
+        pinball->brick_lo |= mask;
+    }
+}
+
+/**
+ * @brief 小球与砖块的碰撞 (常数时间)。
+ * @param old_x 本步移动前的横坐标 (Q8.8)。
+ * @param old_y 本步移动前的纵坐标 (Q8.8)。
+ * @details 每步移动不到一个像素，所以只需看小球中心所在的格子是否有砖块：
+ *          从上下方进入则纵向反弹，从左右进入则横向反弹，斜着撞上砖角则两个方向都反弹。
+ */
+static void pinball_hit_bricks(int16_t old_x, int16_t old_y) {
+    Bitboard bricks = pinball->brick_lo | pinball->brick_hi;
+    int cx = (pinball->ball_x + 128) >> 8, cy = (pinball->ball_y + 128) >> 8;
+    if (!bb_test(bricks, cx, cy)) return;
+
+    int ox = (old_x + 128) >> 8, oy = (old_y + 128) >> 8;
+    Bitboard hit;
+    if (cy != oy && bb_test(bricks, ox, cy)) {
+        hit = bb_bit(ox, cy);          // 砖块在正上方/正下方
+        pinball->vel_y = -pinball->vel_y;
+    } else if (cx != ox && bb_test(bricks, cx, oy)) {
+        hit = bb_bit(cx, oy);          // 砖块在正左方/正右方
+        pinball->vel_x = -pinball->vel_x;
+    } else {
+        hit = bb_bit(cx, cy);          // 砖角，或原本就与砖块重叠
+        if (cy != oy) pinball->vel_y = -pinball->vel_y;
+        if (cx != ox || cy == oy) pinball->vel_x = -pinball->vel_x;
+    }
+    pinball_damage_brick(hit);
+    // 退回移动前的位置，小球不会嵌进砖块
+    pinball->ball_x = old_x;
+    pinball->ball_y = old_y;
+
+    if ((pinball->brick_lo | pinball->brick_hi) == BB_EMPTY) {
+        pinball->state = PINBALL_LEVEL_CLEAR;
+        pinball->game_over_time = millis();
+    }
+}
+
+/**
+ * @brief 推进一个固定步长的物理。
+ */
+static void pinball_step() {
+    // 1. 小球位置更新
+    int16_t old_x = pinball->ball_x, old_y = pinball->ball_y;
+    pinball->ball_x += pinball->vel_x;
+    pinball->ball_y += pinball->vel_y;
+
+    // 2. 碰撞检测：左右墙壁与上墙壁镜面反弹，越过边界的部分折回
+    pinball_reflect(pinball->ball_x, pinball->vel_x, 0, PINBALL_MAX_POS);
+    if (pinball->ball_y < 0) pinball_reflect(pinball->ball_y, pinball->vel_y, 0, PINBALL_MAX_POS);
+    if (pinball_breakout) {
+        pinball_hit_bricks(old_x, old_y);
+        if (pinball->state != PINBALL_RUNNING) return;
+    }
+
+    // 3. 挡板碰撞检测：小球中心下落到挡板上方一行时，判断是否落在挡板上 (含半个像素的边缘)
+    if (pinball->vel_y > 0 && pinball->ball_y >= PINBALL_PADDLE_Y && pinball->ball_y - pinball->vel_y < PINBALL_PADDLE_Y) {
+        int16_t left = pinball->paddle_pos * 256 - 128;
+        int16_t right = (pinball->paddle_pos + PADDLE_LEN - 1) * 256 + 128;
+        if (pinball->ball_x >= left && pinball->ball_x <= right) {
+            // 接住了：反弹角取决于击中位置，越靠近挡板两端越斜
+            int16_t offset = pinball->ball_x - left;                         // 0 .. PADDLE_LEN * 256
+            uint8_t slot = (uint32_t)offset * 9 / (PADDLE_LEN * 256 + 1);
+            int16_t sin_a = pgm_read_word(&pinball_bounce_dir[slot][0]);
+            int16_t cos_a = pgm_read_word(&pinball_bounce_dir[slot][1]);
+            // 游戏加速：提高速率而不是缩短更新间隔
+            pinball->ball_speed += pinball->ball_speed / 16 + 1;
+            if (pinball->ball_speed > PINBALL_SPEED_MAX) pinball->ball_speed = PINBALL_SPEED_MAX;
+            pinball->vel_x = (int32_t)pinball->ball_speed * sin_a / 256;
+            pinball->vel_y = -(int32_t)pinball->ball_speed * cos_a / 256;
+            pinball->ball_y = 2 * PINBALL_PADDLE_Y - pinball->ball_y;
+        }
+    }
+
+    // 4. 没接住：小球越过挡板所在的行后游戏结束
+    if (pinball->ball_y > (BOARD_HEIGHT - 1) * 256 + 128) {
+        pinball->state = PINBALL_GAME_OVER; // 切换到游戏结束状态
+        pinball->game_over_time = millis();         // 记录游戏结束的时刻
+    }
+}
+
+/**
+ * @brief 把 Q8.8 坐标处的小球按覆盖面积分摊到相邻的 2x2 个像素上 (抗锯齿)。
+ * @details 横向、纵向各自在最近的两个像素之间按小数部分线性分配亮度，
+ *          与已有的颜色饱和相加，小球在像素之间移动时亮度连续变化。
+ */
+static void pinball_draw_ball(SYC_WS2812& ws, int16_t x, int16_t y, uint32_t color) {
+    int px = x >> 8, py = y >> 8;
+    uint16_t fx = x & 0xFF, fy = y & 0xFF;
+    for (int dy = 0; dy < 2; dy++) {
+        uint16_t wy = dy ? fy : 256 - fy;
+        for (int dx = 0; dx < 2; dx++) {
+            uint16_t wx = dx ? fx : 256 - fx;
+            uint16_t w = (wx * wy) >> 8; // 0 .. 256
+            int index = pos2index(px + dx, py + dy);
+            if (w == 0 || index < 0) continue;
+            uint32_t part = px_scale(color, w > 255 ? 255 : w - 1);
+            ws.setWs2812Color(index, px_add_sat(ws.led_data[index], part));
+        }
+    }
 }
 
 /**
  * @brief 渲染弹珠游戏。
  */
 void pinball_update_and_render(SYC_WS2812& ws) {
-    if (pinball_state == PINBALL_RUNNING) {
-        if (millis() - game_time > game_speed) {
-            game_time = millis(); // 更新计时器
-
-            // 1. 小球位置更新
-            ball_x += vel_x;
-            ball_y += vel_y;
-
-            // 2. 碰撞检测
-            // 与左右墙壁碰撞，x速度反向
-            if (ball_x >= BOARD_WIDTH - 1 || ball_x <= 0) {
-                vel_x = -vel_x;
-            }
-            // 与上墙壁碰撞，y速度反向
-            if (ball_y <= 0) {
-                vel_y = -vel_y;
-            }
-
-            // 挡板碰撞检测 (在倒数第二行进行)
-            if (ball_y >= BOARD_HEIGHT - 2) {
-                // 判断小球的x坐标是否落在挡板的长度范围内
-                if (ball_x >= paddle_pos && ball_x < paddle_pos + PADDLE_LEN) {
-                    vel_y = -vel_y; // 接住了，y速度反向
-                    if (game_speed > 60) { // 如果速度还没到最快
-                        game_speed -= 20; // 游戏加速
-                    }
-                } else {
-                    // 没接住
-                    pinball_state = PINBALL_GAME_OVER; // 切换到游戏结束状态
-                    game_over_time = millis();         // 记录游戏结束的时刻
-                }
-            }
+    if (pinball->state == PINBALL_RUNNING) {
+        // 固定步长：累计经过的时间，按 PINBALL_STEP_MS 逐步推进物理
+        unsigned long now = millis();
+        pinball->accum_ms += now - pinball->game_time;
+        pinball->game_time = now;
+        uint8_t steps = 0;
+        while (pinball->accum_ms >= PINBALL_STEP_MS && pinball->state == PINBALL_RUNNING) {
+            pinball->accum_ms -= PINBALL_STEP_MS;
+            if (++steps > PINBALL_MAX_STEPS) { pinball->accum_ms = 0; break; } // 卡顿太久，丢弃积压
+            pinball_step();
         }
+    } else if (pinball->state == PINBALL_LEVEL_CLEAR && millis() - pinball->game_over_time > PINBALL_LEVEL_PAUSE) {
+        // 过关停顿结束，进入下一关
+        pinball->brick_level++;
+        pinball_load_level();
+        pinball->state = PINBALL_RUNNING;
+        pinball->game_time = millis();
+        pinball->accum_ms = 0;
     }
 
     // --- 渲染 ---
-    rainbow_hue++; // 色相随时间递增，用于彩虹效果
+    pinball->rainbow_hue++; // 色相随时间递增，用于彩虹效果
 
-    if (pinball_state == PINBALL_RUNNING) {
+    if (pinball->state != PINBALL_GAME_OVER && pinball_breakout) {
+        // 绘制砖块：颜色按剩余耐久区分
+        Bitboard by_strength[4] = {BB_EMPTY, pinball->brick_lo & ~pinball->brick_hi, pinball->brick_hi & ~pinball->brick_lo, pinball->brick_lo & pinball->brick_hi};
+        for (uint8_t n = 1; n <= 3; n++) {
+            if (by_strength[n]) bb_draw(ws, by_strength[n], hsv_wheel(pgm_read_byte(&brick_hue[n])));
+        }
+    }
+    if (pinball->state == PINBALL_LEVEL_CLEAR) {
+        // 过关：挡板闪烁绿色
+        if ((millis() / 150) % 2 == 0) {
+            for (int i = 0; i < PADDLE_LEN; i++) {
+                ws.setWs2812Color(pos2index(pinball->paddle_pos + i, BOARD_HEIGHT - 1), GREEN_Color);
+            }
+        }
+    }
+    if (pinball->state == PINBALL_RUNNING) {
         // 绘制挡板 (白色)
         for (int i = 0; i < PADDLE_LEN; i++) {
-            ws.setWs2812Color(pos2index(paddle_pos + i, BOARD_HEIGHT - 1), WHITE_Color);
+            ws.setWs2812Color(pos2index(pinball->paddle_pos + i, BOARD_HEIGHT - 1), WHITE_Color);
         }
-        // 绘制小球 (彩虹色)
-        ws.setWs2812Color(pos2index(ball_x, ball_y), ws.Wheel(rainbow_hue));
+        // 绘制小球 (彩虹色，亚像素抗锯齿)
+        pinball_draw_ball(ws, pinball->ball_x, pinball->ball_y, hsv_wheel(pinball->rainbow_hue));
     }
-    else if (pinball_state == PINBALL_GAME_OVER) {
+    else if (pinball->state == PINBALL_GAME_OVER) {
         // 绘制 Game Over 闪烁效果 (全屏红色闪烁)
         if ((millis() / 300) % 2 == 0) {
             for (int i = 0; i < ws2812_number; i++) {
@@ -169,52 +358,52 @@ void draw_pinball_icon(SYC_WS2812& ws) {
     const int UPDATE_INTERVAL = 150;       // LOGO动画的更新间隔
 
     // --- 初始化 ---
-    if (!logo_is_initialized) {
-        logo_ball_x = 3; logo_ball_y = 2;  // LOGO小球初始位置
-        logo_vel_x = 1; logo_vel_y = 1;    // LOGO小球初始速度
-        logo_paddle_pos = 2;               // LOGO挡板初始位置
-        logo_last_update_time = millis();  // 初始化计时器
-        logo_is_initialized = true;        // 设置初始化标志
+    if (!pinball->logo_is_initialized) {
+        pinball->logo_ball_x = 3; pinball->logo_ball_y = 2;  // LOGO小球初始位置
+        pinball->logo_vel_x = 1; pinball->logo_vel_y = 1;    // LOGO小球初始速度
+        pinball->logo_paddle_pos = 2;               // LOGO挡板初始位置
+        pinball->logo_last_update_time = millis();  // 初始化计时器
+        pinball->logo_is_initialized = true;        // 设置初始化标志
     }
 
     // --- 逻辑更新 ---
-    if (millis() - logo_last_update_time > UPDATE_INTERVAL) {
-        logo_last_update_time = millis();
+    if (millis() - pinball->logo_last_update_time > UPDATE_INTERVAL) {
+        pinball->logo_last_update_time = millis();
 
         // a. 小球位置更新
-        logo_ball_x += logo_vel_x;
-        logo_ball_y += logo_vel_y;
+        pinball->logo_ball_x += pinball->logo_vel_x;
+        pinball->logo_ball_y += pinball->logo_vel_y;
 
         // b. 小球碰撞检测
         // 左右墙壁反弹
-        if (logo_ball_x >= BOARD_WIDTH - 1 || logo_ball_x <= 0) {
-            logo_vel_x = -logo_vel_x;
+        if (pinball->logo_ball_x >= BOARD_WIDTH - 1 || pinball->logo_ball_x <= 0) {
+            pinball->logo_vel_x = -pinball->logo_vel_x;
         }
         // 上墙壁反弹
-        if (logo_ball_y <= 0) {
-            logo_vel_y = -logo_vel_y;
+        if (pinball->logo_ball_y <= 0) {
+            pinball->logo_vel_y = -pinball->logo_vel_y;
         }
         // 挡板反弹
-        if (logo_ball_y >= BOARD_HEIGHT - 1) {
-            logo_vel_y = -logo_vel_y;
+        if (pinball->logo_ball_y >= BOARD_HEIGHT - 1) {
+            pinball->logo_vel_y = -pinball->logo_vel_y;
         }
 
-        int target_paddle_pos = logo_ball_x - 1;
+        int target_paddle_pos = pinball->logo_ball_x - 1;
         target_paddle_pos = constrain(target_paddle_pos, 0, BOARD_WIDTH - PADDLE_LEN); // 限制在边界内
 
-        if (logo_paddle_pos < target_paddle_pos) {
-            logo_paddle_pos++;
-        } else if (logo_paddle_pos > target_paddle_pos) {
-            logo_paddle_pos--;
+        if (pinball->logo_paddle_pos < target_paddle_pos) {
+            pinball->logo_paddle_pos++;
+        } else if (pinball->logo_paddle_pos > target_paddle_pos) {
+            pinball->logo_paddle_pos--;
         }
     }
 
     // --- 渲染 ---
     // a. 绘制小球 (彩虹色)
-    ws.setWs2812Color(pos2index(logo_ball_x, logo_ball_y), ws.Wheel(millis() / 20));
+    ws.setWs2812Color(pos2index(pinball->logo_ball_x, pinball->logo_ball_y), hsv_wheel(millis() / 20));
     // b. 绘制挡板 (白色)
     for (int i = 0; i < PADDLE_LEN; i++) {
-        ws.setWs2812Color(pos2index(logo_paddle_pos + i, BOARD_HEIGHT - 1), WHITE_Color);
+        ws.setWs2812Color(pos2index(pinball->logo_paddle_pos + i, BOARD_HEIGHT - 1), WHITE_Color);
     }
 }
 
@@ -226,42 +415,289 @@ void draw_pinball_icon(SYC_WS2812& ws) {
 // ---- 游戏配置与变量 ----
 const int GOL_UPDATE_INTERVAL = 200; // 每一代演化的间隔时间 (ms)
 
-// world[0] 存储 0-31 号细胞的状态，world[1] 存储 32-63 号
-uint32_t life_world[2] = {0, 0};
+// 生命游戏的工作状态，进入模式时从模式内存池申请，字段见 LifeData：
+// 整个世界按行存放 (第 y 行第 x 位为 (x, y) 处的细胞)，屏幕显示其中 8x8 的视口 (world)，
+// 视口内的细胞年龄只跟踪 64 个细胞；drawn/cells_drawn 用于只重绘状态或年龄分档变化的细胞。
+static LifeData* life;
+
+/**
+ * @brief 各显示分档的颜色：相对规则色相的偏移、饱和度、明度。
+ */
+struct LifeAgeStyle {
+    int8_t hue_shift;
+    uint8_t sat;
+    uint8_t val;
+};
+
+enum LifeAgeBucket : uint8_t {
+    LIFE_AGE_NEWBORN, // 刚出生
+    LIFE_AGE_YOUNG,   // 存活 1 代
+    LIFE_AGE_ADULT,   // 存活 2 代
+    LIFE_AGE_STABLE,  // 存活 3 代及以上
+    LIFE_AGE_DYING,   // 上一代刚死去
+    LIFE_AGE_STYLES
+};
+
+static const LifeAgeStyle life_age_styles[LIFE_AGE_STYLES] PROGMEM = {
+    { 24, 110, 255}, // 新生：偏向相邻色相、低饱和，接近白色
+    { 12, 255, 255}, // 年轻：明亮
+    {  0, 255, 170}, // 成熟：规则本色
+    {  0, 255,  80}, // 稳定：变暗，让正在演化的区域更突出
+    {-16, 255,  20}, // 刚死去：暗淡的余晖，下一代熄灭
+};
+
+// ---- 视口 ----
+static bool life_view_follow = true; // true: 自动追踪活细胞；false: 手动平移 (设置，不随模式切换清除)
+
+// ---- 规则与边界 ----
+
+/**
+ * @brief 规则预设：名称、规则字符串和活细胞的色相。
+ */
+struct LifeRuleInfo {
+    char rule[14];
+    uint8_t hue;
+};
+
+// 按 LifeRulePreset 编号排列
+static const LifeRuleInfo life_rule_presets[(int)LifeRulePreset::COUNT] PROGMEM = {
+    {"B3/S23",       0},   // 康威生命游戏: 红
+    {"B36/S23",      30},  // 高生命: 橙
+    {"B2/S",         85},  // 种子: 绿
+    {"B3678/S34678", 170}, // 昼夜: 蓝
+};
+
+static LifeRulePreset life_preset = LifeRulePreset::LIFE;
+static LifeRule life_rule = {1 << 3, (1 << 2) | (1 << 3)};
+static uint32_t life_palette[LIFE_AGE_STYLES]; // 各分档的颜色 (由规则的色相生成)
+static bool life_palette_ready = false;
+static bool life_wrap = false;
+
+/**
+ * @brief 画面被清空后调用，下一次渲染时重绘所有活细胞。
+ */
+void gol_invalidate_frame() {
+    life->drawn = BB_EMPTY;
+    life->cells_drawn.age_lo = life->cells_drawn.age_hi = life->cells_drawn.dying = BB_EMPTY;
+}
+
+/**
+ * @brief 把 "B3/S23" 形式的规则字符串编译为出生/存活查找表。
+ */
+bool life_rule_parse(const char* text, LifeRule& rule) {
+    uint16_t* target = NULL;
+    rule.birth = 0;
+    rule.survive = 0;
+    for (const char* p = text; *p; p++) {
+        char c = *p;
+        if (c == 'B' || c == 'b') target = &rule.birth;
+        else if (c == 'S' || c == 's') target = &rule.survive;
+        else if (c >= '0' && c <= '8' && target != NULL) *target |= 1 << (c - '0');
+        else if (c != '/') return false;
+    }
+    return true;
+}
+
+/**
+ * @brief 按规则的色相生成各年龄分档的颜色。
+ */
+static void life_build_palette(uint8_t hue) {
+    for (uint8_t i = 0; i < LIFE_AGE_STYLES; i++) {
+        LifeAgeStyle style;
+        memcpy_P(&style, &life_age_styles[i], sizeof(style));
+        life_palette[i] = hsv_to_grb((uint16_t)(uint8_t)(hue + style.hue_shift) << 8, style.sat, style.val);
+    }
+    life_palette_ready = true;
+}
+
+void gol_set_rule(LifeRulePreset preset) {
+    LifeRuleInfo info;
+    memcpy_P(&info, &life_rule_presets[(int)preset], sizeof(info));
+    life_rule_parse(info.rule, life_rule);
+    life_build_palette(info.hue);
+    life_preset = preset;
+    initGameOfLife();
+    gol_invalidate_frame(); // 颜色可能改变，所有活细胞需要重绘
+}
+
+LifeRulePreset gol_get_rule() {
+    return life_preset;
+}
+
+void gol_set_wrap(bool wrap) {
+    life_wrap = wrap;
+    initGameOfLife();
+}
+
+bool gol_get_wrap() {
+    return life_wrap;
+}
+
+/**
+ * @brief 从世界中取出视口位置的 8x8 区域。
+ */
+static Bitboard life_read_viewport() {
+    Bitboard view = BB_EMPTY;
+    for (uint8_t r = 0; r < 8; r++) {
+        uint8_t line = (uint8_t)(life->universe[life->view_y + r] >> life->view_x);
+        view |= (Bitboard)line << (r * 8);
+    }
+    return view;
+}
+
+/**
+ * @brief 视口从头开始：所有活细胞按新生显示，没有余晖。
+ */
+static void life_reset_viewport() {
+    life->world = life_read_viewport();
+    life->shown_x = life->view_x;
+    life->shown_y = life->view_y;
+    life->cells.age_lo = life->cells.age_hi = life->cells.dying = BB_EMPTY;
+}
+
+/**
+ * @brief 刷新视口 life->world，并根据出生/死亡掩码增量更新年龄位平面。
+ * @param new_generation 为 true 表示世界刚演化了一代，存活的细胞年龄 +1；
+ *                       为 false 表示只是视口移动 (手动平移)，年龄保持不变。
+ * @details 视口移动时年龄位平面随之平移；刚移入视口、年龄未知的活细胞按“稳定”显示。
+ */
+static void life_update_viewport(bool new_generation) {
+    int dx = (int)life->view_x - life->shown_x;
+    int dy = (int)life->view_y - life->shown_y;
+    Bitboard seen = bb_shift(BB_FULL, -dx, -dy);         // 上一个视口中也能看到的格子
+    Bitboard old  = bb_shift(life->world, -dx, -dy);
+    Bitboard lo   = bb_shift(life->cells.age_lo, -dx, -dy);
+    Bitboard hi   = bb_shift(life->cells.age_hi, -dx, -dy);
+    Bitboard now  = life_read_viewport();
+
+    if (new_generation) {
+        // 存活的细胞年龄饱和加一；新生细胞的位平面原本为 0 (死细胞不保留年龄)，即分档 0
+        Bitboard kept = now & old;
+        Bitboard saturated = lo & hi;
+        hi |= lo & kept;
+        lo = (lo ^ kept) | saturated;
+        life->cells.dying = old & ~now;
+    } else {
+        life->cells.dying = bb_shift(life->cells.dying, -dx, -dy);
+    }
+
+    Bitboard unknown = now & ~seen; // 刚进入视口的活细胞
+    life->cells.age_lo = (lo & now) | unknown;
+    life->cells.age_hi = (hi & now) | unknown;
+    life->world = now;
+    life->shown_x = life->view_x;
+    life->shown_y = life->view_y;
+}
+
+/**
+ * @brief 把视口坐标向 target 移动一格 (跟随模式下每一代最多移动一格，画面不会跳动)。
+ */
+static uint8_t life_view_approach(uint8_t pos, int target, uint8_t limit) {
+    if (target < 0) target = 0;
+    if (target > limit) target = limit;
+    if (pos < target) return pos + 1;
+    if (pos > target) return pos - 1;
+    return pos;
+}
+
+/**
+ * @brief 跟随模式：让视口中心靠近这一代发生变化的细胞的包围盒中心。
+ * @details 追踪变化而不是所有活细胞，视口会停在仍在演化的区域，而不是静物之间的空地。
+ * @param rows 发生变化的行 (第 y 位为第 y 行)。
+ * @param cols 发生变化的列 (第 x 位为第 x 列)。
+ */
+static void life_follow_activity(uint32_t rows, uint32_t cols) {
+    if (rows == 0) return; // 没有变化，由停滞检测重新播种
+
+    int left = bb_ctz32(cols);
+    int right = 31 - __builtin_clz(cols);
+    int top = bb_ctz32(rows);
+    int bottom = 31 - __builtin_clz(rows);
+    life->view_x = life_view_approach(life->view_x, (left + right + 1) / 2 - 4, GOL_UNIVERSE_WIDTH - 8);
+    life->view_y = life_view_approach(life->view_y, (top + bottom + 1) / 2 - 4, GOL_UNIVERSE_HEIGHT - 8);
+}
 
-// ---- 游戏流程控制 ----
-unsigned long gol_last_update_time = 0; // 上次演化的时间戳
+/**
+ * @brief 手动平移视口半屏，越过世界边缘后回到另一侧。
+ */
+static uint8_t life_view_pan(uint8_t pos, uint8_t limit) {
+    if (pos >= limit) return 0;
+    return (pos + 4 > limit) ? limit : pos + 4;
+}
+
+void gol_handle_input(KeyEvent event) {
+    if (event == KeyEvent::LEFT_LONG_PRESS) {
+        life_view_follow = !life_view_follow;
+        return;
+    }
+    if (event == KeyEvent::RIGHT_DOUBLE_CLICK) {
+        // 双击之前的两次单击已经生效 (环面开关切换两次即复原)，再重新开始演化
+        initGameOfLife();
+        return;
+    }
+    if (life_view_follow) {
+        if (event == KeyEvent::LEFT_CLICK) {
+            gol_set_rule(static_cast<LifeRulePreset>(((int)life_preset + 1) % (int)LifeRulePreset::COUNT));
+        } else if (event == KeyEvent::RIGHT_CLICK) {
+            gol_set_wrap(!life_wrap);
+        }
+    } else {
+        if (event == KeyEvent::LEFT_CLICK) {
+            life->view_x = life_view_pan(life->view_x, GOL_UNIVERSE_WIDTH - 8);
+        } else if (event == KeyEvent::RIGHT_CLICK) {
+            life->view_y = life_view_pan(life->view_y, GOL_UNIVERSE_HEIGHT - 8);
+        }
+        life_update_viewport(false);
+    }
+}
 
 /**
- * @brief 根据一维索引获取细胞状态。
+ * @brief 整个世界的 32 位哈希 (逐行乘法混合后再做一次扩散)。
+ */
+static uint32_t life_hash() {
+    uint32_t h = 0;
+    for (uint8_t y = 0; y < GOL_UNIVERSE_HEIGHT; y++) {
+        h = (h ^ life->universe[y]) * 0x9E3779B1UL;
+    }
+    h ^= h >> 15;
+    h *= 0x85EBCA77UL;
+    return h ^ (h >> 13);
+}
+
+/**
+ * @brief 记录新一代的世界，并判断它是否在最近 GOL_CYCLE_MAX_PERIOD 代内出现过。
+ * @return true 表示进入了周期不超过 GOL_CYCLE_MAX_PERIOD 的循环 (含静止)。
+ */
+static bool life_check_cycle() {
+    uint32_t h = life_hash();
+    for (uint8_t i = 0; i < life->history_len; i++) {
+        if (life->history[i] == h) return true;
+    }
+    life->history[life->history_pos] = h;
+    life->history_pos = (life->history_pos + 1) % GOL_CYCLE_MAX_PERIOD;
+    if (life->history_len < GOL_CYCLE_MAX_PERIOD) life->history_len++;
+    return false;
+}
+
+/**
+ * @brief 根据一维索引获取视口内的细胞状态。
  * @param index 细胞索引 (0-63)。
  * @return 1 表示存活，0 表示死亡。
  */
 int getCellState(int index) {
     if (index < 0 || index >= 64) return 0; // 边界检查
-    
-    if (index < 32) {
-        // 在第一个整数中，通过位运算获取状态
-        return (life_world[0] >> index) & 1;
-    } else {
-        // 在第二个整数中，索引要相应调整
-        return (life_world[1] >> (index - 32)) & 1;
-    }
+    return bb_test_index(life->world, index);
 }
 
 /**
- * @brief 根据二维坐标获取细胞状态。
- * @param x 横坐标 (0-7)。
- * @param y 纵坐标 (0-7)。
+ * @brief 根据世界坐标获取细胞状态。
+ * @param x 横坐标 (0 ~ GOL_UNIVERSE_WIDTH-1)。
+ * @param y 纵坐标 (0 ~ GOL_UNIVERSE_HEIGHT-1)。
  * @return 1 表示存活，0 表示死亡。
  */
 int getCellStateXY(int x, int y) {
-    if (x < 0 || x >= 8 || y < 0 || y >= 8) {
-        return 0; // 边界之外视为死亡细胞
-    }
-    // 灯珠为行式排布，计算对应的一维索引
-    int index = y * 8 + x;
-    return getCellState(index);
+    if (x < 0 || x >= GOL_UNIVERSE_WIDTH || y < 0 || y >= GOL_UNIVERSE_HEIGHT) return 0; // 边界之外视为死亡细胞
+    return (life->universe[y] >> x) & 1;
 }
 
 /**
@@ -282,88 +718,119 @@ int countNeighbors(int x, int y) {
 }
 
 /**
- * @brief 根据生命游戏规则计算下一代的世界状态。
+ * @brief 按规则把按行存储的世界演化一代。
+ * @details 每一行用位切片加法器一次算出整行细胞的邻居数 (一行一个字)，
+ *          死细胞的邻居数在出生集合中则出生，活细胞的邻居数在存活集合中则存活。
+ *          计算第 y 行时第 y-1 行已被覆盖，所以用 above 保存它的旧值。
+ *          同时记录发生变化的行和列，供视口追踪使用。
  */
-void computeNextGeneration() {
-    uint32_t next_world[2] = {0, 0}; // 创建一个临时的数组来存储下一代的状态
-
-    for (int x = 0; x < 8; x++) {
-        for (int y = 0; y < 8; y++) {
-            int index = y * 8 + x; // 同样使用列式排布的索引
-            
-            int neighbors = countNeighbors(x, y);
-            int current_state = getCellState(index);
-            bool is_alive_next = false; // 默认为死亡
-
-            // 应用康威生命游戏的三条核心规则
-            // 规则1 & 2: 活细胞在邻居为2或3时继续存活
-            if (current_state == 1 && (neighbors == 2 || neighbors == 3)) {
-                is_alive_next = true;
-            } 
-            // 规则3: 死细胞在邻居恰好为3时复活
-            else if (current_state == 0 && neighbors == 3) {
-                is_alive_next = true;
-            }
-
-            // 如果下一代该细胞是存活的，则在 next_world 的相应位上置1
-            if (is_alive_next) {
-                if (index < 32) {
-                    next_world[0] |= (1UL << index);
-                } else {
-                    next_world[1] |= (1UL << (index - 32));
-                }
-            }
+uint32_t life_universe_step(uint32_t* rows, uint8_t width, uint8_t height, const LifeRule& rule, bool wrap,
+                            uint32_t* changed_cols) {
+    uint32_t mask = bb_row_mask(width);
+    uint32_t changed_rows = 0, cols = 0;
+    bool birth_on_empty = rule.birth & 1; // B0 规则下空白区域也会变化，不能跳过
+    uint32_t first = rows[0];
+    uint32_t above = wrap ? rows[height - 1] : 0;
+    for (uint8_t y = 0; y < height; y++) {
+        uint32_t row = rows[y];
+        uint32_t below = (y + 1 < height) ? rows[y + 1] : (wrap ? first : 0);
+        if ((above | row | below) == 0 && !birth_on_empty) {
+            above = row;
+            continue; // 三行全空，本行下一代仍为空
         }
+        RowCount neighbors;
+        bb_row_neighbor_count(above, row, below, width, wrap, neighbors);
+        uint32_t next = ((bb_row_count_in(neighbors, rule.birth) & ~row)
+                       | (bb_row_count_in(neighbors, rule.survive) & row)) & mask;
+        if (next != row) {
+            changed_rows |= 1UL << y;
+            cols |= next ^ row;
+        }
+        rows[y] = next;
+        above = row;
     }
-    
-    // 用计算出的新世界覆盖当前世界
-    life_world[0] = next_world[0];
-    life_world[1] = next_world[1];
+    if (changed_cols != NULL) *changed_cols = cols;
+    return changed_rows;
+}
+
+/**
+ * @brief 根据当前规则计算下一代的世界状态，并刷新视口。
+ */
+void computeNextGeneration() {
+    uint32_t changed_cols;
+    uint32_t changed_rows = life_universe_step(life->universe, GOL_UNIVERSE_WIDTH, GOL_UNIVERSE_HEIGHT,
+                                               life_rule, life_wrap, &changed_cols);
+    if (life_view_follow) life_follow_activity(changed_rows, changed_cols);
+    life_update_viewport(true);
+}
+
+/**
+ * @brief 世界中是否还有活细胞。
+ */
+static bool life_is_empty() {
+    uint32_t any = 0;
+    for (uint8_t y = 0; y < GOL_UNIVERSE_HEIGHT; y++) any |= life->universe[y];
+    return any == 0;
+}
+
+void gol_enter() {
+    life = mode_claim<LifeData>();
+    initGameOfLife();
 }
 
 /**
  * @brief 初始化或重置生命游戏，随机生成初始细胞图案。
  */
 void initGameOfLife() {
-    life_world[0] = 0; // 清空世界
-    life_world[1] = 0;
+    memset(life->universe, 0, sizeof(life->universe)); // 清空世界
     // 随机填充约20%的细胞作为初始状态
-    for (int i = 0; i < 64 / 5; i++) {
-        int index = random(64);
-        if (index < 32) {
-            life_world[0] |= (1UL << index);
-        } else {
-            life_world[1] |= (1UL << (index - 32));
-        }
+    for (int i = 0; i < GOL_UNIVERSE_WIDTH * GOL_UNIVERSE_HEIGHT / 5; i++) {
+        uint8_t x = rng_below(RNG_STREAM_LIFE, GOL_UNIVERSE_WIDTH);
+        uint8_t y = rng_below(RNG_STREAM_LIFE, GOL_UNIVERSE_HEIGHT);
+        life->universe[y] |= 1UL << x;
     }
+    // 视口回到世界中央
+    life->view_x = (GOL_UNIVERSE_WIDTH - 8) / 2;
+    life->view_y = (GOL_UNIVERSE_HEIGHT - 8) / 2;
+    life_reset_viewport();
+    // 新的世界，清空周期检测的历史
+    life->history_len = 0;
+    life->history_pos = 0;
+    life_check_cycle();
 }
 
 /**
  * @brief 生命游戏的主更新与渲染函数。
  */
 void updateAndRenderGameOfLife(SYC_WS2812& ws) {
-    // --- 渲染当前世界 ---
-    for (int i = 0; i < 64; i++) {
-        if (getCellState(i)) {
-            ws.setWs2812Color(i, RED_Color); // 活细胞为红色
-        } else {
-            ws.setWs2812Color(i, BLACK_Color); // 死细胞为黑色
-        }
+    // --- 渲染当前世界：只重绘状态或年龄分档与上一次绘制相比发生变化的细胞 ---
+    // 画面由 render_frame() 保留并统一发送，这里不再调用 Ws2812_show()
+    if (!life_palette_ready) life_build_palette(pgm_read_byte(&life_rule_presets[(int)life_preset].hue));
+    Bitboard changed = (life->world ^ life->drawn)
+                     | (life->cells.age_lo ^ life->cells_drawn.age_lo)
+                     | (life->cells.age_hi ^ life->cells_drawn.age_hi)
+                     | (life->cells.dying ^ life->cells_drawn.dying);
+    if (changed != BB_EMPTY) {
+        Bitboard alive = changed & life->world;
+        Bitboard lo = life->cells.age_lo, hi = life->cells.age_hi;
+        bb_draw(ws, changed & ~life->world & ~life->cells.dying, BLACK_Color);    // 熄灭的细胞
+        bb_draw(ws, changed & life->cells.dying, life_palette[LIFE_AGE_DYING]); // 刚死去的余晖
+        bb_draw(ws, alive & ~hi & ~lo, life_palette[LIFE_AGE_NEWBORN]);
+        bb_draw(ws, alive & ~hi &  lo, life_palette[LIFE_AGE_YOUNG]);
+        bb_draw(ws, alive &  hi & ~lo, life_palette[LIFE_AGE_ADULT]);
+        bb_draw(ws, alive &  hi &  lo, life_palette[LIFE_AGE_STABLE]);
+        life->drawn = life->world;
+        life->cells_drawn = life->cells;
     }
-    ws.Ws2812_show(); // 推送颜色数据到LED
 
     // --- 定时演化下一代 ---
-    if (millis() - gol_last_update_time > GOL_UPDATE_INTERVAL) {
-        gol_last_update_time = millis();
-        
-        // 保存当前世界状态，用于检测演化是否停滞
-        uint32_t old_world[2] = {life_world[0], life_world[1]};
+    if (millis() - life->last_update_time > GOL_UPDATE_INTERVAL) {
+        life->last_update_time = millis();
         
         computeNextGeneration(); // 计算下一代
 
-        // 简化的停滞检测：如果世界全灭，或者状态不再变化，则重新开始
-        if ((life_world[0] == 0 && life_world[1] == 0) ||
-            (life_world[0] == old_world[0] && life_world[1] == old_world[1])) {
+        // 停滞检测：世界全灭，或者回到了最近几代中出现过的状态 (静止或周期振荡)，则重新开始
+        if (life_is_empty() || life_check_cycle()) {
             initGameOfLife();
         }
     }
@@ -395,52 +862,172 @@ void draw_gol_icon(SYC_WS2812& ws, uint16_t interval) {
 /******************************************************************************
  *                            贪吃蛇游戏 (Snake)
  ******************************************************************************/
-#define SNAKE_MAX_LENGTH 64 // 蛇的最大长度
-
-// 贪吃蛇游戏状态枚举
-enum class SnakeState { IDLE, RUNNING, GAME_OVER };
-
-// 蛇的前进方向枚举
-enum class SnakeDirection { UP, DOWN, LEFT, RIGHT };
-
 // --- 游戏变量 ---
-SnakeState snake_state;         // 当前游戏状态
-SnakeDirection snake_dir;       // 当前前进方向
+// 贪吃蛇的工作状态，进入模式时从模式内存池申请，字段见 SnakeData。
+// 蛇身存放在环形缓冲区中，每一节是一个格子索引 (y * 8 + x)，
+// 前进时只写入新的蛇头、移走蛇尾，与蛇的长度无关；occupied 与 cells 同步更新。
+static SnakeData* snake;
 
 // 使用坐标结构体来表示一个点
 struct Point { int8_t x; int8_t y; };
 
-Point snake_body[SNAKE_MAX_LENGTH]; // 数组，存储蛇身每一节的坐标
-uint8_t snake_len;                  // 蛇的当前长度
-Point food;                         // 食物的坐标
-
-unsigned long snake_last_move_time; // 上次移动的时间戳
 int snake_move_interval = 350;      // 移动的时间间隔 (ms)
 
+// --- 自动驾驶 (演示模式) ---
+const unsigned long SNAKE_ATTRACT_DELAY = 10000; // 游戏结束后无操作多久进入演示模式 (ms)
+const unsigned long SNAKE_DEMO_RESTART = 1500;   // 演示模式下游戏结束后多久重新开始 (ms)
+const int SNAKE_PREVIEW_INTERVAL = 150;          // 菜单预览中蛇的移动间隔 (ms)
+
 /**
- * @brief 初始化或重置贪吃蛇游戏。
+ * @brief 在蛇头前方加入一节。
  */
-void snake_init() {
-    snake_state = SnakeState::RUNNING; // 设置状态为运行中
-    snake_len = 3;                     // 初始长度为3
-    // 初始化蛇身在屏幕中间
-    snake_body[0] = {4, 4}; // 头
-    snake_body[1] = {3, 4};
-    snake_body[2] = {2, 4};
-    snake_dir = SnakeDirection::RIGHT; // 初始方向向右
+static void snake_push_head(uint8_t cell) {
+    snake->head = (snake->head + 1) & (SNAKE_MAX_LENGTH - 1);
+    snake->cells[snake->head] = cell;
+    snake->occupied |= (Bitboard)1 << cell;
+    snake->len++;
+}
+
+/**
+ * @brief 移走蛇尾的一节。
+ */
+static void snake_pop_tail() {
+    snake->occupied &= ~((Bitboard)1 << snake->cells[snake->tail]);
+    snake->tail = (snake->tail + 1) & (SNAKE_MAX_LENGTH - 1);
+    snake->len--;
+}
+
+/**
+ * @brief 在没有蛇身的格子中等概率地放置食物。
+ * @details 空格数用 popcount 得到，再用 select 取出第 n 个空格，不需要重试。
+ * @return 棋盘已被蛇身占满时返回 false。
+ */
+static bool snake_place_food() {
+    Bitboard free_cells = ~snake->occupied;
+    uint8_t count = bb_popcount(free_cells);
+    if (count == 0) return false;
+    snake->food = bb_select(free_cells, rng_below(RNG_STREAM_SNAKE, count));
+    return true;
+}
+
+/**
+ * @brief 重新开始一局，保留自动驾驶的开关。
+ */
+static void snake_reset() {
+    snake->state = SnakeState::RUNNING; // 设置状态为运行中
+    // 初始化蛇身在屏幕中间，长度为3，从尾到头依次加入
+    snake->len = 0;
+    snake->occupied = BB_EMPTY;
+    snake->tail = 0;
+    snake->head = SNAKE_MAX_LENGTH - 1;
+    snake_push_head(4 * BOARD_WIDTH + 2);
+    snake_push_head(4 * BOARD_WIDTH + 3);
+    snake_push_head(4 * BOARD_WIDTH + 4); // 头
+    snake->dir = SnakeDirection::RIGHT; // 初始方向向右
+    snake->turn_count = 0;              // 清空转向队列
     
     // 随机生成一个食物
-    food = {random(BOARD_WIDTH), random(BOARD_HEIGHT)};
+    snake_place_food();
+
+    snake->last_move_time = millis(); // 重置移动计时器
+}
+
+/**
+ * @brief 初始化或重置贪吃蛇游戏 (由玩家操控)。
+ */
+void snake_init() {
+    snake->autopilot = false;
+    snake_reset();
+}
 
-    snake_last_move_time = millis(); // 重置移动计时器
+void snake_enter() {
+    snake = mode_claim<SnakeData>();
+    snake_init();
+}
+
+void snake_set_autopilot(bool on) {
+    snake->autopilot = on;
+    snake->turn_count = 0;
+}
+
+bool snake_get_autopilot() {
+    return snake->autopilot;
+}
+
+SnakeState snake_get_state() {
+    return snake->state;
+}
+
+uint8_t snake_get_length() {
+    return snake->len;
+}
+
+/**
+ * @brief 按键对应的新方向。
+ * @param dir 转向前的方向。
+ * @param left_key true 为左键，false 为右键。
+ */
+static SnakeDirection snake_turn(SnakeDirection dir, bool left_key) {
+    switch(dir) {
+        case SnakeDirection::UP:    return left_key ? SnakeDirection::LEFT : SnakeDirection::RIGHT;
+        case SnakeDirection::DOWN:  return left_key ? SnakeDirection::LEFT : SnakeDirection::RIGHT;
+        case SnakeDirection::LEFT:  return left_key ? SnakeDirection::DOWN : SnakeDirection::UP;
+        default:                    return left_key ? SnakeDirection::UP   : SnakeDirection::DOWN;
+    }
+}
+
+/**
+ * @brief 两个方向是否相反。
+ */
+static bool snake_is_reverse(SnakeDirection a, SnakeDirection b) {
+    // UP/DOWN、LEFT/RIGHT 的编号相邻，且成对从偶数开始
+    return ((int)a ^ 1) == (int)b;
+}
+
+/**
+ * @brief 把一次转向加入队列。
+ * @details 转向基于队尾的方向计算 (队列为空时基于实际前进方向)，
+ *          所以快速连按两次会依次生效，而不是只剩最后一次。队列满时丢弃。
+ */
+static void snake_queue_turn(bool left_key) {
+    if (snake->turn_count >= SNAKE_TURN_QUEUE_SIZE) return;
+    SnakeDirection base = snake->dir;
+    if (snake->turn_count > 0) {
+        base = snake->turns[(snake->turn_first + snake->turn_count - 1) % SNAKE_TURN_QUEUE_SIZE];
+    }
+    snake->turns[(snake->turn_first + snake->turn_count) % SNAKE_TURN_QUEUE_SIZE] = snake_turn(base, left_key);
+    snake->turn_count++;
+}
+
+/**
+ * @brief 前进一步之前取出一个转向。
+ * @details 与实际前进方向相同或相反的转向 (会原地掉头) 被丢弃，继续取下一个。
+ */
+static void snake_apply_turn() {
+    while (snake->turn_count > 0) {
+        SnakeDirection next = snake->turns[snake->turn_first];
+        snake->turn_first = (snake->turn_first + 1) % SNAKE_TURN_QUEUE_SIZE;
+        snake->turn_count--;
+        if (next != snake->dir && !snake_is_reverse(next, snake->dir)) {
+            snake->dir = next;
+            return;
+        }
+    }
 }
 
 /**
  * @brief 处理贪吃蛇游戏中的按键输入。
  * @param event 传入的按键事件。
+ * @details 左键长按开关自动驾驶；自动驾驶时单击按键由玩家接管。
  */
 void snake_handle_input(KeyEvent event) {
-    if (snake_state == SnakeState::GAME_OVER) {
+    if (event == KeyEvent::LEFT_LONG_PRESS) {
+        // 自动驾驶要求蛇身沿哈密顿回路排列，所以切换时重新开始一局
+        snake_set_autopilot(!snake->autopilot);
+        snake_reset();
+        return;
+    }
+    if (snake->state == SnakeState::GAME_OVER || snake->state == SnakeState::WON) {
         // 如果游戏结束，任意单击事件都将重新开始
         if (event == KeyEvent::LEFT_CLICK || event == KeyEvent::RIGHT_CLICK) {
             snake_init();
@@ -448,239 +1035,207 @@ void snake_handle_input(KeyEvent event) {
         return;
     }
 
-    // 左键控制蛇
-    if (event == KeyEvent::LEFT_CLICK) {
-        switch(snake_dir) {
-            case SnakeDirection::UP:    snake_dir = SnakeDirection::LEFT; break;
-            case SnakeDirection::DOWN:  snake_dir = SnakeDirection::LEFT; break;
-            case SnakeDirection::LEFT:  snake_dir = SnakeDirection::DOWN; break;
-            case SnakeDirection::RIGHT: snake_dir = SnakeDirection::UP; break;
-        }
-    } 
-    // 右键控制蛇
-    else if (event == KeyEvent::RIGHT_CLICK) {
-        switch(snake_dir) {
-            case SnakeDirection::UP:    snake_dir = SnakeDirection::RIGHT; break;
-            case SnakeDirection::DOWN:  snake_dir = SnakeDirection::RIGHT; break;
-            case SnakeDirection::LEFT:  snake_dir = SnakeDirection::UP; break;
-            case SnakeDirection::RIGHT: snake_dir = SnakeDirection::DOWN; break;
-        }
+    // 左键、右键分别在当前方向的基础上转向
+    if (event == KeyEvent::LEFT_CLICK || event == KeyEvent::RIGHT_CLICK) {
+        snake->autopilot = false; // 演示中按键，玩家接管
+        snake_queue_turn(event == KeyEvent::LEFT_CLICK);
     }
 }
 
+/******************************************************************************
+ *                      贪吃蛇自动驾驶 (位棋盘寻路)
+ ******************************************************************************/
+
 /**
- * @brief 贪吃蛇游戏的逻辑与渲染函数。
+ * @brief 哈密顿回路上 cell 的下一个格子。
+ * @details 回路：第 0 行从左走到右，第 1-7 列按行蛇形往返 (奇数行向左、偶数行向右)，
+ *          最后沿第 0 列从下往上回到起点。
  */
-void snake_update_and_render(SYC_WS2812& ws) {
-    ws.clearWs2812(); // 每帧开始时清空屏幕
-    
-    // -- 1. 逻辑更新 (基于时间间隔) --
-    if (snake_state == SnakeState::RUNNING && millis() - snake_last_move_time > snake_move_interval) {
-        snake_last_move_time = millis();
-
-        Point next_head = snake_body[0]; // 获取当前蛇头的位置
-
-        // 根据前进方向计算下一帧蛇头的新位置
-        if (snake_dir == SnakeDirection::UP)    next_head.y--;
-        if (snake_dir == SnakeDirection::DOWN)  next_head.y++;
-        if (snake_dir == SnakeDirection::LEFT)  next_head.x--;
-        if (snake_dir == SnakeDirection::RIGHT) next_head.x++;
+static uint8_t snake_cycle_next(uint8_t cell) {
+    uint8_t x = cell % BOARD_WIDTH, y = cell / BOARD_WIDTH;
+    if (x == 0) return (y > 0) ? cell - BOARD_WIDTH : cell + 1; // 第 0 列向上，到顶后右转
+    if (y % 2 == 0) return (x < BOARD_WIDTH - 1) ? cell + 1 : cell + BOARD_WIDTH;
+    if (x > 1) return cell - 1;
+    return (y < BOARD_HEIGHT - 1) ? cell + BOARD_WIDTH : cell - 1; // 最后一行走到第 0 列
+}
 
-        // 检查碰撞
-        // a. 撞墙
-        if (next_head.x < 0 || next_head.x >= BOARD_WIDTH || next_head.y < 0 || next_head.y >= BOARD_HEIGHT) {
-            snake_state = SnakeState::GAME_OVER;
-        }
-        // b. 撞到自己
-        for (int i = 0; i < snake_len; i++) {
-            if (next_head.x == snake_body[i].x && next_head.y == snake_body[i].y) {
-                snake_state = SnakeState::GAME_OVER;
-                break;
-            }
-        }
-        
-        // 如果游戏已结束，则跳过后续的移动和吃食物逻辑
-        if (snake_state == SnakeState::GAME_OVER) {
+/**
+ * @brief cell 在哈密顿回路上的序号 (0-63)，(0, 0) 为 0，与 snake_cycle_next() 一致。
+ */
+static uint8_t snake_cycle_order(uint8_t cell) {
+    uint8_t x = cell % BOARD_WIDTH, y = cell / BOARD_WIDTH;
+    if (y == 0) return x;
+    if (x == 0) return 57 + (BOARD_HEIGHT - 1 - y);          // 第 0 列：8 + 7*7 = 57 之后
+    uint8_t base = BOARD_WIDTH + (y - 1) * (BOARD_WIDTH - 1);
+    return base + ((y % 2) ? (BOARD_WIDTH - 1 - x) : (x - 1));
+}
 
-        } else {
-            // c. 吃到食物
-            bool ate_food = (next_head.x == food.x && next_head.y == food.y);
-            if (ate_food) {
-                if (snake_len < SNAKE_MAX_LENGTH) {
-                    snake_len++; // 蛇身变长
-                }
-                // 在新位置生成食物
-                food = {random(BOARD_WIDTH), random(BOARD_HEIGHT)};
-            }
+/**
+ * @brief 沿哈密顿回路从 from 走到 to 的步数。
+ */
+static uint8_t snake_cycle_distance(uint8_t from, uint8_t to) {
+    return (snake_cycle_order(to) - snake_cycle_order(from)) & (SNAKE_MAX_LENGTH - 1);
+}
 
-            // 移动蛇身 (核心)
-            // 从尾部开始，将每一节身体移动到其前一节的位置
-            for (int i = snake_len - 1; i > 0; i--) {
-                snake_body[i] = snake_body[i-1];
-            }
-            snake_body[0] = next_head;
+/**
+ * @brief 为自动驾驶选择下一步要走的格子。
+ * @details 自动驾驶始终保持一个不变量：沿哈密顿回路从蛇尾走到蛇头，经过所有蛇身；
+ *          从蛇头往前到蛇尾的这一段回路全是空格。只要下一步落在这段空格里，
+ *          不变量就仍然成立，回路上的下一格永远可走，所以蛇不会死，最终会占满棋盘。
+ *
+ *          在此前提下用 BFS 抄近路：从食物出发在空格上逐层扩张 (位棋盘整体向四邻扩张一格，
+ *          不需要队列)，按离食物由近到远检查蛇头的相邻格子，取第一个满足
+ *          “在蛇头与蛇尾之间的空格段内，且不越过食物”的格子；都不满足时沿回路走一格。
+ * @return 下一步的格子索引。
+ */
+static uint8_t snake_autopilot_choose() {
+    uint8_t head = snake->cells[snake->head];
+    uint8_t tail_cell = snake->cells[snake->tail];
+    Bitboard passable = ~snake->occupied | ((Bitboard)1 << tail_cell); // 蛇尾会在这一步让出来
+    Bitboard moves = bb_neighbors4((Bitboard)1 << head) & passable;
+    uint8_t to_tail = snake_cycle_distance(head, tail_cell);
+    uint8_t to_food = snake_cycle_distance(head, snake->food);
+
+    // 从食物出发逐层扩张，按离食物的距离从近到远检查相邻格子
+    Bitboard frontier = (Bitboard)1 << snake->food;
+    Bitboard visited = frontier;
+    while (frontier) {
+        Bitboard hit = frontier & moves;
+        while (hit) {
+            uint8_t cell = bb_pop_lsb(hit);
+            uint8_t d = snake_cycle_distance(head, cell);
+            if (d < to_tail && d <= to_food) return cell;
         }
+        frontier = bb_neighbors4(frontier) & passable & ~visited;
+        visited |= frontier;
     }
 
-    // -- 2. 渲染 --
-    if (snake_state == SnakeState::RUNNING) {
-        // 渲染蛇身，蛇头为白色，身体为红色
-        for (int i = 0; i < snake_len; i++) {
-            int index = snake_body[i].y * BOARD_WIDTH + snake_body[i].x; 
-            ws.setWs2812Color(index, i == 0 ? WHITE_Color : RED_Color);
-        }
-        // 渲染食物 (绿色)
-        if( (millis()/200) % 2 == 0) {
-            int food_index = food.y * BOARD_WIDTH + food.x;
-                ws.setWs2812Color(food_index, GREEN_Color);
-        }
-    } else if (snake_state == SnakeState::GAME_OVER) {
-        // 游戏结束时，全屏红色闪烁
-        if ((millis() / 300) % 2 == 0) {
-            for(int i=0; i<64; i++) ws.setWs2812Color(i, RED_Color);
-        }
-    }
+    // 沿哈密顿回路走一格
+    return snake_cycle_next(head);
 }
 
 /**
- * @brief 绘制贪吃蛇的动态图标。
- * @param ws SYC_WS2812驱动对象的引用。
+ * @brief 让自动驾驶决定下一步的方向。
  */
-void draw_snake_icon(SYC_WS2812& ws)
-{
-    // --- Logo动画配置 ---
-    const int SNAKE_LENGTH = 5;         // 图标中蛇的长度
-    const int ANIMATION_INTERVAL = 150; // 移动间隔
-    
-    // 定义蛇的运动路径范围
-    const int PATH_MIN_COORD = 1;
-    const int PATH_MAX_COORD = BOARD_WIDTH - 2;
-
-    // 定义一个固定的食物位置
-    const Point FIXED_APPLE_POSITION = {6, 3};
-
-    // --- 静态变量，保存动画状态 ---
-    static bool is_initialized = false;
-    static Point snake_body[SNAKE_LENGTH];
-    static int direction;
-    static unsigned long last_move_time;
-    static bool is_apple_active;
-    
-    // --- 初始化逻辑 ---
-    if (!is_initialized) {
-        // 设置蛇的初始位置和方向
-        for (int i = 0; i < SNAKE_LENGTH; i++) {
-            snake_body[i] = { (float)(SNAKE_LENGTH - i + PATH_MIN_COORD - 1), PATH_MIN_COORD };
-        }
-        direction = 0; 
-        is_apple_active = true; // 初始时苹果可见
-        last_move_time = millis();
-        is_initialized = true;
-    }
-
-    // --- 动画逻辑更新 ---
-    if (millis() - last_move_time > ANIMATION_INTERVAL) {
-        last_move_time = millis();
-
-        Point current_head = snake_body[0];
-        Point next_head = current_head;
-
-        bool just_completed_lap = false;
-        if (direction == 0 && current_head.x == PATH_MAX_COORD)      direction = 1;
-        else if (direction == 1 && current_head.y == PATH_MAX_COORD) direction = 2;
-        else if (direction == 2 && current_head.x == PATH_MIN_COORD) direction = 3;
-        else if (direction == 3 && current_head.y == PATH_MIN_COORD) {             
-            direction = 0;
-            just_completed_lap = true;
-        }
-        
-        if (direction == 0) next_head.x++;
-        if (direction == 1) next_head.y++;
-        if (direction == 2) next_head.x--;
-        if (direction == 3) next_head.y--;
-
-        if (is_apple_active && next_head.x == FIXED_APPLE_POSITION.x && next_head.y == FIXED_APPLE_POSITION.y) {
-            is_apple_active = false;
-        }
+static void snake_autopilot_steer() {
+    uint8_t head = snake->cells[snake->head];
+    uint8_t cell = snake_autopilot_choose();
+    if (cell == head - BOARD_WIDTH) snake->dir = SnakeDirection::UP;
+    else if (cell == head + BOARD_WIDTH) snake->dir = SnakeDirection::DOWN;
+    else if (cell == head - 1) snake->dir = SnakeDirection::LEFT;
+    else snake->dir = SnakeDirection::RIGHT;
+}
 
-        for (int i = SNAKE_LENGTH - 1; i > 0; i--) {
-            snake_body[i] = snake_body[i - 1];
-        }
-        snake_body[0] = next_head;
+/******************************************************************************
+ *                            贪吃蛇逻辑与渲染
+ ******************************************************************************/
 
-        if (just_completed_lap) {
-            is_apple_active = true;
-        }
+/**
+ * @brief 蛇前进一步 (转向、碰撞、吃食物)。
+ */
+void snake_step() {
+    if (snake->state != SnakeState::RUNNING) return;
+    if (snake->autopilot) {
+        snake_autopilot_steer();
+    } else {
+        snake_apply_turn(); // 每一步最多应用一次排队的转向
     }
-    
-    // --- 渲染 ---
-    ws.clearWs2812();
 
-    if (is_apple_active && (millis() / 250) % 2 == 0) {
-        int apple_index = FIXED_APPLE_POSITION.y * BOARD_WIDTH + FIXED_APPLE_POSITION.x;
-        ws.setWs2812Color(apple_index, GREEN_Color); 
-    }
+    uint8_t head = snake->cells[snake->head];
+    Point next_head = {(int8_t)(head % BOARD_WIDTH), (int8_t)(head / BOARD_WIDTH)}; // 获取当前蛇头的位置
+
+    // 根据前进方向计算下一帧蛇头的新位置
+    if (snake->dir == SnakeDirection::UP)    next_head.y--;
+    if (snake->dir == SnakeDirection::DOWN)  next_head.y++;
+    if (snake->dir == SnakeDirection::LEFT)  next_head.x--;
+    if (snake->dir == SnakeDirection::RIGHT) next_head.x++;
 
-    // 渲染蛇身
-    for (int i = 0; i < SNAKE_LENGTH; i++) {
-        int index = snake_body[i].y * BOARD_WIDTH + snake_body[i].x;
-        if (index >= 0 && index < BOARD_WIDTH * BOARD_HEIGHT) {
-            ws.setWs2812Color(index, i == 0 ? WHITE_Color : RED_Color);
+    // 检查碰撞
+    // a. 撞墙
+    if (next_head.x < 0 || next_head.x >= BOARD_WIDTH || next_head.y < 0 || next_head.y >= BOARD_HEIGHT) {
+        snake->state = SnakeState::GAME_OVER;
+    } else {
+        uint8_t next_cell = next_head.y * BOARD_WIDTH + next_head.x;
+        bool ate_food = (next_cell == snake->food);
+
+        // 没吃到食物时蛇尾先移走，蛇头可以进入蛇尾刚离开的格子
+        if (!ate_food) snake_pop_tail();
+
+        // b. 撞到自己：查占用位棋盘，不需要遍历蛇身
+        if (bb_test_index(snake->occupied, next_cell)) {
+            snake->state = SnakeState::GAME_OVER;
+        } else {
+            // 移动蛇身 (核心)：只加入新的蛇头
+            snake_push_head(next_cell);
+            // c. 吃到食物，在空格中生成新的食物；没有空格说明蛇已占满棋盘
+            if (ate_food && !snake_place_food()) {
+                snake->state = SnakeState::WON;
+            }
         }
     }
+    if (snake->state != SnakeState::RUNNING) snake->over_time = millis();
 }
 
-
-/******************************************************************************
- *                             游戏管理接口
- ******************************************************************************/
-
 /**
- * @brief 根据指定的模式开始一个游戏。
- * @param mode 要开始的游戏模式。
+ * @brief 绘制蛇和食物 (游戏结束时全屏闪烁)。
  */
-void game_start(GameMode mode) {
-    switch(mode) {
-        case GameMode::SNAKE:
-            snake_init();
-            break;
-        case GameMode::PINBALL:
-            pinball_init();
-            break;
-        case GameMode::GAME_OF_LIFE:
-            initGameOfLife();
-            break;
+static void snake_render(SYC_WS2812& ws) {
+    ws.clearWs2812(); // 每帧开始时清空屏幕
+    if (snake->state == SnakeState::RUNNING) {
+        // 渲染蛇身，蛇头为白色，身体为红色
+        uint8_t head = snake->cells[snake->head];
+        bb_draw(ws, snake->occupied & ~((Bitboard)1 << head), RED_Color);
+        ws.setWs2812Color(head, WHITE_Color);
+        // 渲染食物 (绿色)
+        if( (millis()/200) % 2 == 0) {
+            ws.setWs2812Color(snake->food, GREEN_Color);
+        }
+    } else if (snake->state == SnakeState::GAME_OVER || snake->state == SnakeState::WON) {
+        // 游戏结束时全屏闪烁：失败为红色，占满棋盘为绿色
+        if ((millis() / 300) % 2 == 0) {
+            uint32_t color = (snake->state == SnakeState::WON) ? GREEN_Color : RED_Color;
+            for(int i=0; i<64; i++) ws.setWs2812Color(i, color);
+        }
     }
 }
 
 /**
- * @brief 将按键输入事件分发给当前正在运行的游戏。
- * @param event 传入的按键事件。
+ * @brief 贪吃蛇游戏的逻辑与渲染函数。
  */
-void game_handle_input(KeyEvent event) {
-    switch(appState.game_mode) {
-        case GameMode::SNAKE:
-            snake_handle_input(event);
-            break;
-        case GameMode::PINBALL:
-            pinball_handle_input(event);
-            break;
+void snake_update_and_render(SYC_WS2812& ws) {
+    // -- 1. 逻辑更新 (基于时间间隔) --
+    if (snake->state == SnakeState::RUNNING && millis() - snake->last_move_time > (unsigned long)snake_move_interval) {
+        snake->last_move_time = millis();
+        snake_step();
+    } else if (snake->state != SnakeState::RUNNING) {
+        // 演示模式下自动重开；玩家的游戏结束后长时间无操作，也进入演示模式
+        unsigned long idle = millis() - snake->over_time;
+        if (snake->autopilot ? idle > SNAKE_DEMO_RESTART : idle > SNAKE_ATTRACT_DELAY) {
+            snake->autopilot = true;
+            snake_reset();
+        }
     }
+
+    // -- 2. 渲染 --
+    snake_render(ws);
 }
 
 /**
- * @brief 根据当前游戏模式，调用相应的更新和渲染函数。
+ * @brief 绘制贪吃蛇的动态图标：由自动驾驶实时玩一局作为菜单预览。
+ * @param ws SYC_WS2812驱动对象的引用。
  */
-void game_update_and_render(SYC_WS2812& ws) {
-    switch(appState.game_mode) {
-        case GameMode::SNAKE:
-            snake_update_and_render(ws);
-            break;
-        case GameMode::PINBALL:
-            pinball_update_and_render(ws);
-            break;
-        case GameMode::GAME_OF_LIFE:
-            updateAndRenderGameOfLife(ws);
-            break;
+void draw_snake_icon(SYC_WS2812& ws)
+{
+    // 预览与游戏共用同一份状态；进入游戏时 game_start() 会重新初始化
+    if (!snake->autopilot) {
+        snake->autopilot = true;
+        snake_reset();
     }
-}
\ No newline at end of file
+    if (snake->state == SnakeState::RUNNING && millis() - snake->last_move_time > SNAKE_PREVIEW_INTERVAL) {
+        snake->last_move_time = millis();
+        snake_step();
+    } else if (snake->state != SnakeState::RUNNING && millis() - snake->over_time > SNAKE_DEMO_RESTART) {
+        snake_reset();
+    }
+    snake_render(ws);
+}
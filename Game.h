@@ -14,6 +14,10 @@
 #define _GAME_H_
 
 #include "Device.h"
+#include "Bitboard.h"
+#include "Random.h"
+#include "Color.h"
+#include "Pixel.h"
 
 /******************************************************************************
  *                             游戏通用配置
@@ -33,16 +37,135 @@
  *                        康威生命游戏 (Game of Life)
  ******************************************************************************/
 /**
- * @brief 根据一维索引获取细胞状态。
+ * @brief 周期检测能发现的最长振荡周期 (代)，每一代占用 4 字节历史记录。
+ */
+#ifndef GOL_CYCLE_MAX_PERIOD
+#define GOL_CYCLE_MAX_PERIOD 8
+#endif
+
+/**
+ * @brief 生命游戏世界的大小 (8-32)。世界按行存为 uint32_t 数组，每行占 4 字节，
+ *        屏幕只显示其中一个 8x8 的视口。
+ */
+#ifndef GOL_UNIVERSE_WIDTH
+#define GOL_UNIVERSE_WIDTH 32
+#endif
+#ifndef GOL_UNIVERSE_HEIGHT
+#define GOL_UNIVERSE_HEIGHT 32
+#endif
+#if GOL_UNIVERSE_WIDTH < 8 || GOL_UNIVERSE_WIDTH > 32 || GOL_UNIVERSE_HEIGHT < 8 || GOL_UNIVERSE_HEIGHT > 32
+#error "GOL_UNIVERSE_WIDTH / GOL_UNIVERSE_HEIGHT 必须在 8 到 32 之间"
+#endif
+
+/**
+ * @brief 编译后的类生命规则：第 n 位为 1 表示邻居数为 n 时出生/存活。
+ */
+struct LifeRule {
+    uint16_t birth;
+    uint16_t survive;
+};
+
+/**
+ * @brief 视口内每个细胞的显示状态，按位平面保存。
+ * @details 活细胞的年龄分档 (0-3) 用 age_lo/age_hi 两个位平面做饱和计数，
+ *          dying 为上一代刚死去、还在显示余晖的细胞。
+ */
+struct LifeCells {
+    Bitboard age_lo;
+    Bitboard age_hi;
+    Bitboard dying;
+};
+
+/**
+ * @brief 生命游戏的工作状态 (由 gol_enter() 从模式内存池申请，initGameOfLife() 初始化)。
+ */
+struct LifeData {
+    uint32_t universe[GOL_UNIVERSE_HEIGHT];   // 整个世界，第 y 行第 x 位为 (x, y) 处的细胞
+    Bitboard world;                           // 当前视口，第 i 位为屏幕上的 i 号细胞
+    LifeCells cells;                          // 视口内细胞的年龄与余晖
+    Bitboard drawn;                           // 上一次绘制到画面上的视口
+    LifeCells cells_drawn;                    // 上一次绘制时的显示状态
+    uint8_t view_x, view_y;                   // 视口左上角在世界中的坐标
+    uint8_t shown_x, shown_y;                 // world 与 cells 当前对应的视口坐标
+    uint32_t history[GOL_CYCLE_MAX_PERIOD];   // 最近几代世界的哈希值 (环形缓冲区)
+    uint8_t history_pos;
+    uint8_t history_len;
+    unsigned long last_update_time;           // 上次演化的时间戳
+};
+
+/**
+ * @brief 内置的规则预设。
+ */
+enum class LifeRulePreset : uint8_t {
+    LIFE,          // B3/S23      康威生命游戏
+    HIGHLIFE,      // B36/S23     高生命
+    SEEDS,         // B2/S        种子 (每个细胞只活一代)
+    DAY_AND_NIGHT, // B3678/S34678 昼夜
+    COUNT
+};
+
+/**
+ * @brief 把 "B3/S23" 形式的规则字符串编译为出生/存活查找表。
+ * @param text 规则字符串 (不区分大小写，B 和 S 两段的顺序任意)。
+ * @param rule 输出的规则。
+ * @return 字符串合法时返回 true。
+ */
+bool life_rule_parse(const char* text, LifeRule& rule);
+
+/**
+ * @brief 切换规则预设，并重新开始演化。
+ */
+void gol_set_rule(LifeRulePreset preset);
+
+/**
+ * @brief 获取当前的规则预设。
+ */
+LifeRulePreset gol_get_rule(void);
+
+/**
+ * @brief 设置环面模式 (上下、左右边界相连)。
+ */
+void gol_set_wrap(bool wrap);
+
+/**
+ * @brief 当前是否为环面模式。
+ */
+bool gol_get_wrap(void);
+
+/**
+ * @brief 生命游戏的按键处理。
+ * @details 左键长按在“跟随”和“平移”之间切换视口模式。
+ *          跟随模式：视口自动追踪活细胞，左键切换规则，右键切换环面模式；
+ *          平移模式：视口固定，左键向右、右键向下平移半屏 (到边缘后回到另一侧)。
+ *          右键双击重新随机生成世界。
+ */
+void gol_handle_input(KeyEvent event);
+
+/**
+ * @brief 按规则把按行存储的世界演化一代 (原地更新)。
+ * @param rows 世界的各行，第 x 位为第 x 列。
+ * @param width 世界宽度 (1-32)。
+ * @param height 世界高度。
+ * @param rule 出生/存活规则。
+ * @param wrap 为 true 时为环面世界。
+ * @param changed_cols 不为 NULL 时输出发生变化的列 (第 x 位为第 x 列)。
+ * @return 发生变化的行 (第 y 位为第 y 行)。
+ * @details 只保留上一行的旧值，逐行计算；上中下三行全空 (且规则不含 B0) 的行直接跳过。
+ */
+uint32_t life_universe_step(uint32_t* rows, uint8_t width, uint8_t height, const LifeRule& rule, bool wrap,
+                            uint32_t* changed_cols = NULL);
+
+/**
+ * @brief 根据一维索引获取视口内的细胞状态。
  * @param index 细胞索引 (0-63)。
  * @return 1 (存活) 或 0 (死亡)。
  */
 int getCellState(int index);
 
 /**
- * @brief 根据二维坐标获取细胞状态。
- * @param x 横坐标 (0-7)。
- * @param y 纵坐标 (0-7)。
+ * @brief 根据世界坐标获取细胞状态。
+ * @param x 横坐标 (0 ~ GOL_UNIVERSE_WIDTH-1)。
+ * @param y 纵坐标 (0 ~ GOL_UNIVERSE_HEIGHT-1)。
  * @return 1 (存活) 或 0 (死亡)。
  */
 int getCellStateXY(int x, int y);
@@ -56,12 +179,17 @@ int getCellStateXY(int x, int y);
 int countNeighbors(int x, int y);
 
 /**
- * @brief 计算并更新到下一代的世界状态。
+ * @brief 按当前规则和边界模式计算并更新到下一代的世界状态，并刷新视口。
  */
 void computeNextGeneration(void);
 
 /**
- * @brief 初始化生命游戏，随机生成初始世界。
+ * @brief 进入生命游戏：从模式内存池申请世界，并开始新的演化。
+ */
+void gol_enter(void);
+
+/**
+ * @brief 初始化生命游戏，随机生成初始世界，视口回到世界中央。
  */
 void initGameOfLife(void);
 
@@ -70,6 +198,11 @@ void initGameOfLife(void);
  */
 void updateAndRenderGameOfLife(SYC_WS2812& ws);
 
+/**
+ * @brief 通知生命游戏画面已被清空，下一帧重绘所有活细胞 (平时只重绘变化的细胞)。
+ */
+void gol_invalidate_frame(void);
+
 /**
  * @brief 绘制生命游戏的静态切换图标。
  * @param interval 图标帧切换的间隔时间(ms)。
@@ -82,10 +215,81 @@ void draw_gol_icon(SYC_WS2812& ws, uint16_t interval);
  ******************************************************************************/
 
 /**
- * @brief 初始化或重置贪吃蛇游戏。
+ * @brief 贪吃蛇的最大长度 (整个棋盘)，必须是 2 的幂，蛇身环形缓冲区用掩码回绕。
+ */
+#define SNAKE_MAX_LENGTH 64
+
+/**
+ * @brief 贪吃蛇游戏状态。
+ */
+enum class SnakeState { IDLE, RUNNING, GAME_OVER, WON };
+
+/**
+ * @brief 蛇的前进方向。
+ */
+enum class SnakeDirection { UP, DOWN, LEFT, RIGHT };
+
+/**
+ * @brief 转向队列的容量：一个移动间隔内的多次按键依次保存，每前进一步应用一次。
+ */
+#define SNAKE_TURN_QUEUE_SIZE 3
+
+/**
+ * @brief 贪吃蛇的工作状态 (由 snake_enter() 从模式内存池申请，snake_init() 初始化)。
+ */
+struct SnakeData {
+    SnakeState state;                              // 当前游戏状态
+    SnakeDirection dir;                            // 当前前进方向
+    uint8_t cells[SNAKE_MAX_LENGTH];               // 蛇身环形缓冲区，每一节是一个格子索引 (y * 8 + x)
+    uint8_t head;                                  // 蛇头在环形缓冲区中的位置
+    uint8_t tail;                                  // 蛇尾在环形缓冲区中的位置
+    uint8_t len;                                   // 蛇的当前长度
+    Bitboard occupied;                             // 蛇身占据的格子
+    uint8_t food;                                  // 食物所在的格子索引
+    unsigned long last_move_time;                  // 上次移动的时间戳
+    SnakeDirection turns[SNAKE_TURN_QUEUE_SIZE];   // 转向队列
+    uint8_t turn_first;                            // 队首在数组中的位置
+    uint8_t turn_count;                            // 队列中的转向数
+    bool autopilot;                                // 自动驾驶 (演示模式)
+    unsigned long over_time;                       // 进入游戏结束状态的时间戳
+};
+
+/**
+ * @brief 进入贪吃蛇：从模式内存池申请状态，并开始新的一局。
+ */
+void snake_enter(void);
+
+/**
+ * @brief 初始化或重置贪吃蛇游戏 (由玩家操控，关闭自动驾驶)。
  */
 void snake_init(void);
 
+/**
+ * @brief 开关自动驾驶 (演示模式)：由位棋盘寻路代替玩家操控。
+ * @note 自动驾驶要求从新的一局开始 (蛇身沿哈密顿回路排列)，应在 snake_init() 之后立即打开。
+ */
+void snake_set_autopilot(bool on);
+
+/**
+ * @brief 当前是否为自动驾驶。
+ */
+bool snake_get_autopilot(void);
+
+/**
+ * @brief 不等待移动间隔，立即让蛇前进一步 (自动驾驶时先寻路)。
+ */
+void snake_step(void);
+
+/**
+ * @brief 获取当前的游戏状态。
+ */
+SnakeState snake_get_state(void);
+
+/**
+ * @brief 获取蛇的当前长度。
+ */
+uint8_t snake_get_length(void);
+
 /**
  * @brief 处理贪吃蛇游戏中的按键输入。
  * @param event 传入的按键事件。
@@ -98,7 +302,7 @@ void snake_handle_input(KeyEvent event);
 void snake_update_and_render(SYC_WS2812& ws);
 
 /**
- * @brief 绘制贪吃蛇的动态图标。
+ * @brief 绘制贪吃蛇的动态图标 (自动驾驶实时演示)。
  */
 void draw_snake_icon(SYC_WS2812& ws);
 
@@ -108,46 +312,73 @@ void draw_snake_icon(SYC_WS2812& ws);
  ******************************************************************************/
 
 /**
- * @brief 初始化或重置弹珠游戏的状态。
+ * @brief 弹珠游戏的状态。
  */
-void pinball_init(void);
+enum PinballState {
+    PINBALL_RUNNING,     // 游戏运行中
+    PINBALL_LEVEL_CLEAR, // 打砖块：本关砖块全部击碎，短暂停顿后进入下一关
+    PINBALL_GAME_OVER    // 游戏结束
+};
 
 /**
- * @brief 处理弹珠游戏中的按键输入。
- * @param event 传入的按键事件。
+ * @brief 弹珠游戏 (及其菜单动态LOGO) 的工作状态，由 pinball_enter() 从模式内存池申请。
+ * @details 小球的位置和速度都是 Q8.8 定点数。
  */
-void pinball_handle_input(KeyEvent event);
+struct PinballData {
+    PinballState state;
+    int16_t ball_x, ball_y;               // 小球的坐标 (Q8.8)
+    int16_t vel_x, vel_y;                 // 小球的速度向量 (Q8.8 像素/步)
+    int16_t ball_speed;                   // 小球的速率 (Q8.8 像素/步)
+    int paddle_pos;                       // 挡板的左端x坐标
+    unsigned long accum_ms;               // 尚未推进的物理时间 (ms)
+    unsigned long game_time;              // 上一帧的时间，用于累计物理时间
+    unsigned long game_over_time;         // 进入 Game Over (或过关) 状态的时刻
+    uint8_t rainbow_hue;                  // 小球的彩虹色相
+    Bitboard brick_lo, brick_hi;          // 打砖块：砖块耐久的两个位平面
+    uint8_t brick_level;                  // 打砖块：当前关卡
+    int logo_ball_x, logo_ball_y;         // LOGO小球坐标
+    int logo_vel_x, logo_vel_y;           // LOGO小球速度
+    int logo_paddle_pos;                  // LOGO挡板位置
+    unsigned long logo_last_update_time;  // LOGO上次更新时间
+    bool logo_is_initialized;             // LOGO动画是否已初始化
+};
 
 /**
- * @brief 更新弹珠游戏的逻辑并渲染到LED矩阵上。
- * @param ws SYC_WS2812驱动对象的引用。
+ * @brief 进入弹珠游戏：从模式内存池申请状态，并开始新的一局。
  */
-void pinball_update_and_render(SYC_WS2812& ws);
+void pinball_enter(void);
 
 /**
- * @brief 绘制弹珠游戏的动态LOGO。
+ * @brief 初始化或重置弹珠游戏的状态。
  */
-void draw_pinball_icon(SYC_WS2812& ws);
+void pinball_init(void);
 
-/******************************************************************************
- *                             游戏管理接口
- ******************************************************************************/
+/**
+ * @brief 切换打砖块模式 (上方有按关卡排布的多耐久砖块)，并重新开始。
+ */
+void pinball_set_breakout(bool on);
 
 /**
- * @brief 根据指定的模式开始一个游戏。
- * @param mode 要开始的游戏模式。
+ * @brief 当前是否为打砖块模式。
  */
-void game_start(GameMode mode);
+bool pinball_get_breakout(void);
 
 /**
- * @brief 将按键输入事件分发给当前正在运行的游戏。
+ * @brief 处理弹珠游戏中的按键输入。
  * @param event 传入的按键事件。
+ * @details 左右键移动挡板；左键长按在弹珠与打砖块之间切换。
  */
-void game_handle_input(KeyEvent event);
+void pinball_handle_input(KeyEvent event);
 
 /**
- * @brief 根据当前游戏模式，调用相应的更新和渲染函数。
+ * @brief 更新弹珠游戏的逻辑并渲染到LED矩阵上。
+ * @param ws SYC_WS2812驱动对象的引用。
  */
-void game_update_and_render(SYC_WS2812& ws);
+void pinball_update_and_render(SYC_WS2812& ws);
+
+/**
+ * @brief 绘制弹珠游戏的动态LOGO。
+ */
+void draw_pinball_icon(SYC_WS2812& ws);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,300 @@
+/**
+ * @file Mode.cpp
+ * @author 多嘴龙虾
+ * @brief 模式注册表：全屏动画、图片、游戏、字母和数字的统一描述与调度
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * 本文件把各模块的函数适配为统一的钩子，并按 ModeId / MainMode 编号排成 PROGMEM 表。
+ * 增加一个模式只需：实现钩子、在 ModeId 和 mode_table 中各加一项、
+ * 并在对应的主菜单项中把 count 加一。
+ */
+
+#include "Mode.h"
+#include "Animation.h"
+#include "Game.h"
+#include "Profiler.h"
+
+static ModeId mode_active = ModeId::NONE;
+
+/******************************************************************************
+ *                               帧率配置 (fps)
+ ******************************************************************************/
+const uint8_t FPS_STATIC        = 20; // 图片、字母、数字
+const uint8_t FPS_FLAME         = 30;
+const uint8_t FPS_RAINBOW       = 50;
+const uint8_t FPS_RAINBOW_HEART = 20;
+const uint8_t FPS_PARTICLES     = 30; // 流星雨、烟花、雨滴、火花
+const uint8_t FPS_PINBALL       = 50;
+const uint8_t FPS_SNAKE         = 30;
+const uint8_t FPS_GAME_OF_LIFE  = 20;
+
+
+/******************************************************************************
+ *                          模式内存池预算 (字节)
+ ******************************************************************************/
+// 每个模式声明的预算。状态结构体变大时由下面的 static_assert 报错，需要有意识地调整预算
+#if FLAME_PALETTE_IN_RAM
+const uint16_t ARENA_FLAME     = 1160; // 热度图 + RAM 中的调色板副本
+#else
+const uint16_t ARENA_FLAME     = 136;
+#endif
+const uint16_t ARENA_PARTICLES = 504;
+const uint16_t ARENA_PINBALL   = 112;
+const uint16_t ARENA_SNAKE     = 128;
+const uint16_t ARENA_LIFE      = 240;
+
+// 每个模式的 init 钩子只申请一个状态结构体：它不超过预算，就不会超出内存池，mode_claim() 不会返回 NULL
+static_assert(mode_arena_round(sizeof(FlameState))     <= ARENA_FLAME,     "FlameState 超出 ARENA_FLAME 预算");
+static_assert(mode_arena_round(sizeof(ParticleSystem)) <= ARENA_PARTICLES, "ParticleSystem 超出 ARENA_PARTICLES 预算");
+static_assert(mode_arena_round(sizeof(PinballData))    <= ARENA_PINBALL,   "PinballData 超出 ARENA_PINBALL 预算");
+static_assert(mode_arena_round(sizeof(SnakeData))      <= ARENA_SNAKE,     "SnakeData 超出 ARENA_SNAKE 预算");
+static_assert(mode_arena_round(sizeof(LifeData))       <= ARENA_LIFE,      "LifeData 超出 ARENA_LIFE 预算");
+
+/**
+ * @brief 模式内存池的上限 (字节)。可在编译选项中修改，超出时编译失败。
+ * @note 默认值容纳了 FLAME_PALETTE_IN_RAM 时最大的火焰状态，同时给 4KB 的 SRAM 留出栈和驱动缓冲区。
+ */
+#ifndef MODE_ARENA_LIMIT
+#define MODE_ARENA_LIMIT 1280
+#endif
+
+
+
+/******************************************************************************
+ *                                 位图表
+ ******************************************************************************/
+
+/**
+ * @brief 一张彩色图片：点阵与调色。
+ */
+struct PicEntry {
+    const uint32_t* num;
+    const uint8_t* color;
+};
+
+static const PicEntry pic_table[] PROGMEM = {
+    {Cat, Cat_color}, {Peach, Peach_color}, {Heart, Heart_color},
+    {Dark, Dark_color}, {Sword, Sword_color}, {Dog, Dog_color},
+};
+const uint8_t PIC_COUNT = sizeof(pic_table) / sizeof(pic_table[0]);
+
+static const uint32_t* const letter_table[] PROGMEM = {
+    letter_a_num, letter_b_num, letter_c_num, letter_d_num, letter_e_num, letter_f_num, letter_g_num,
+    letter_h_num, letter_i_num, letter_j_num, letter_k_num, letter_l_num, letter_m_num, letter_n_num,
+    letter_o_num, letter_p_num, letter_q_num, letter_r_num, letter_s_num, letter_t_num, letter_u_num,
+    letter_v_num, letter_w_num, letter_x_num, letter_y_num, letter_z_num,
+};
+const uint8_t LETTER_COUNT = sizeof(letter_table) / sizeof(letter_table[0]);
+
+static const uint32_t* const number_table[] PROGMEM = {
+    number_0_num, number_1_num, number_2_num, number_3_num, number_4_num,
+    number_5_num, number_6_num, number_7_num, number_8_num, number_9_num,
+};
+const uint8_t NUMBER_COUNT = sizeof(number_table) / sizeof(number_table[0]);
+
+
+/******************************************************************************
+ *                               钩子适配函数
+ ******************************************************************************/
+
+// ---- 动画 ----
+static void flame_input(KeyEvent event) {
+    // 右键单击切换火焰调色板
+    if (event == KeyEvent::RIGHT_CLICK) {
+        flame_set_palette(static_cast<FlamePalette>(((int)flame_get_palette() + 1) % (int)FlamePalette::COUNT));
+    }
+}
+
+static void flame_frame(SYC_WS2812& ws, uint8_t, uint8_t sim_steps) {
+    for (uint8_t s = 0; s < sim_steps; s++) flameEffect_lowRam(ws, 30, 200, false);
+}
+
+static void rainbow_frame(SYC_WS2812& ws, uint8_t, uint8_t) {
+    anim_rainbow_flow(ws, 20, 2);
+}
+
+static void rainbow_heart_frame(SYC_WS2812& ws, uint8_t, uint8_t) {
+    anim_beating_heart(ws, 250);
+}
+
+template <ParticleEffect EFFECT>
+static void particles_frame(SYC_WS2812& ws, uint8_t, uint8_t sim_steps) {
+    for (uint8_t s = 0; s < sim_steps; s++) anim_particles(ws, EFFECT, 1000 / FPS_PARTICLES);
+}
+
+// ---- 静态图案 ----
+static void pic_frame(SYC_WS2812& ws, uint8_t variant, uint8_t) {
+    PicEntry pic;
+    memcpy_P(&pic, &pic_table[variant], sizeof(pic));
+    ws.Draw_pic(pic.num, pic.color);
+}
+
+static void letter_frame(SYC_WS2812& ws, uint8_t variant, uint8_t) {
+    ws.Rainbow_bitmap(20, (const uint32_t*)pgm_read_ptr(&letter_table[variant]));
+}
+
+static void number_frame(SYC_WS2812& ws, uint8_t variant, uint8_t) {
+    ws.Rainbow_bitmap(20, (const uint32_t*)pgm_read_ptr(&number_table[variant]));
+}
+
+// ---- 游戏 ----
+static void pinball_frame(SYC_WS2812& ws, uint8_t, uint8_t) {
+    pinball_update_and_render(ws);
+}
+
+static void snake_frame(SYC_WS2812& ws, uint8_t, uint8_t) {
+    snake_update_and_render(ws);
+}
+
+static void life_frame(SYC_WS2812& ws, uint8_t, uint8_t) {
+    updateAndRenderGameOfLife(ws);
+}
+
+static void life_icon(SYC_WS2812& ws) {
+    draw_gol_icon(ws, 250);
+}
+
+// ---- 主菜单图标 ----
+static void anim_main_icon(SYC_WS2812& ws)   { anim_logo(ws, 250); }
+static void pic_main_icon(SYC_WS2812& ws)    { ws.Draw_pic(pic_icon_num, pic_icon_color); }
+static void game_main_icon(SYC_WS2812& ws)   { ws.Draw_pic(snake_icon_num, snake_icon_color); }
+static void letter_main_icon(SYC_WS2812& ws) { ws.Rainbow_bitmap(20, letter_icon_num); }
+static void number_main_icon(SYC_WS2812& ws) { ws.Rainbow_bitmap(20, number_icon_num); }
+static void tool_main_icon(SYC_WS2812& ws)   { ws.Rainbow_bitmap(20, tool_icon_num); }
+
+
+/******************************************************************************
+ *                                  注册表
+ ******************************************************************************/
+
+// 按 ModeId 编号排列 (constexpr：编译期据此计算模式内存池的大小)
+static constexpr ModeDesc mode_table[(int)ModeId::COUNT] PROGMEM = {
+    // init                  exit                 input                 frame                                       icon               invalidate            fps                variants      flags          arena_bytes
+    {flame_enter,            NULL,                flame_input,          flame_frame,                                NULL,              NULL,                 FPS_FLAME,         1,            0,             ARENA_FLAME},
+    {NULL,                   NULL,                NULL,                 rainbow_frame,                              NULL,              NULL,                 FPS_RAINBOW,       1,            0,             0},
+    {NULL,                   NULL,                NULL,                 rainbow_heart_frame,                        NULL,              NULL,                 FPS_RAINBOW_HEART, 1,            0,             0},
+    {anim_particles_enter,   anim_particles_stop, NULL,                 particles_frame<ParticleEffect::METEOR>,    NULL,              NULL,                 FPS_PARTICLES,     1,            MODE_RETAINED, ARENA_PARTICLES},
+    {anim_particles_enter,   anim_particles_stop, NULL,                 particles_frame<ParticleEffect::FIREWORKS>, NULL,              NULL,                 FPS_PARTICLES,     1,            MODE_RETAINED, ARENA_PARTICLES},
+    {anim_particles_enter,   anim_particles_stop, NULL,                 particles_frame<ParticleEffect::RAIN>,      NULL,              NULL,                 FPS_PARTICLES,     1,            MODE_RETAINED, ARENA_PARTICLES},
+    {anim_particles_enter,   anim_particles_stop, NULL,                 particles_frame<ParticleEffect::SPARKS>,    NULL,              NULL,                 FPS_PARTICLES,     1,            MODE_RETAINED, ARENA_PARTICLES},
+    {NULL,                   NULL,                NULL,                 pic_frame,                                  NULL,              NULL,                 FPS_STATIC,        PIC_COUNT,    0,             0},
+    {pinball_enter,          NULL,                pinball_handle_input, pinball_frame,                              draw_pinball_icon, NULL,                 FPS_PINBALL,       1,            0,             ARENA_PINBALL},
+    {snake_enter,            NULL,                snake_handle_input,   snake_frame,                                draw_snake_icon,   NULL,                 FPS_SNAKE,         1,            0,             ARENA_SNAKE},
+    {gol_enter,              NULL,                gol_handle_input,     life_frame,                                 life_icon,         gol_invalidate_frame, FPS_GAME_OF_LIFE,  1,            MODE_RETAINED, ARENA_LIFE},
+    {NULL,                   NULL,                NULL,                 letter_frame,                               NULL,              NULL,                 FPS_STATIC,        LETTER_COUNT, 0,             0},
+    {NULL,                   NULL,                NULL,                 number_frame,                               NULL,              NULL,                 FPS_STATIC,        NUMBER_COUNT, 0,             0},
+};
+
+// 按 MainMode 编号排列
+static const MainModeDesc main_mode_table[MAIN_MODE_COUNT] PROGMEM = {
+    {anim_main_icon,   ModeId::FLAME,   (int)ModeId::SPARKS - (int)ModeId::FLAME + 1,          MAIN_CYCLE},    // 动画：火焰 ... 火花
+    {pic_main_icon,    ModeId::PIC,     PIC_COUNT,                                             MAIN_CYCLE},
+    {game_main_icon,   ModeId::PINBALL, (int)ModeId::GAME_OF_LIFE - (int)ModeId::PINBALL + 1,  MAIN_SUB_MENU}, // 游戏：弹珠、贪吃蛇、生命游戏
+    {letter_main_icon, ModeId::LETTER,  LETTER_COUNT,                                          MAIN_CYCLE},
+    {number_main_icon, ModeId::NUMBER,  NUMBER_COUNT,                                          MAIN_CYCLE},
+    {tool_main_icon,   ModeId::NONE,    0,                                                     MAIN_SUB_MENU}, // 工具：亮度设置 (不是模式)
+};
+
+static_assert(PROF_MODE_COUNT == PROF_MODE_FLAME + (int)ModeId::COUNT, "ProfileMode 必须与 ModeId 一一对应");
+
+
+/******************************************************************************
+ *                              模式内存池 (Arena)
+ ******************************************************************************/
+
+// 编译期求所有模式预算的最大值 (写成单条 return 的递归，兼容 C++11 的 constexpr)
+static constexpr uint16_t arena_max_budget(int i) {
+    return i >= (int)ModeId::COUNT ? 0
+         : (mode_table[i].arena_bytes > arena_max_budget(i + 1) ? mode_table[i].arena_bytes : arena_max_budget(i + 1));
+}
+
+static constexpr uint16_t MODE_ARENA_SIZE = arena_max_budget(0);
+
+static_assert(MODE_ARENA_SIZE > 0, "至少有一个模式需要模式内存池");
+static_assert(MODE_ARENA_SIZE <= MODE_ARENA_LIMIT, "模式内存池超出 MODE_ARENA_LIMIT，请缩小最大模式的状态");
+
+alignas(MODE_ARENA_ALIGN) static uint8_t mode_arena[MODE_ARENA_SIZE];
+static uint16_t arena_top = 0;                          // 下一次分配的偏移
+static uint16_t arena_peak_bytes[(int)ModeId::COUNT];   // 每个模式的最高用量
+static uint16_t arena_failures = 0;
+
+void* mode_alloc(size_t bytes) {
+    uint16_t size = mode_arena_round(bytes);
+    if (mode_active == ModeId::NONE || size > MODE_ARENA_SIZE - arena_top) {
+        arena_failures++;
+        return NULL;
+    }
+    void* p = &mode_arena[arena_top];
+    arena_top += size;
+    if (arena_top > arena_peak_bytes[(int)mode_active]) arena_peak_bytes[(int)mode_active] = arena_top;
+    return p;
+}
+
+uint16_t mode_arena_capacity() {
+    return MODE_ARENA_SIZE;
+}
+
+uint16_t mode_arena_budget(ModeId id) {
+    return pgm_read_word(&mode_table[(int)id].arena_bytes);
+}
+
+uint16_t mode_arena_peak(ModeId id) {
+    return arena_peak_bytes[(int)id];
+}
+
+uint16_t mode_arena_failures() {
+    return arena_failures;
+}
+
+void mode_get(ModeId id, ModeDesc& desc) {
+    memcpy_P(&desc, &mode_table[(int)id], sizeof(desc));
+}
+
+void main_mode_get(MainMode main, MainModeDesc& desc) {
+    memcpy_P(&desc, &main_mode_table[(int)main], sizeof(desc));
+}
+
+ModeId main_mode_item(MainMode main, uint8_t item, uint8_t& variant) {
+    MainModeDesc m;
+    main_mode_get(main, m);
+    variant = 0;
+    if (m.first == ModeId::NONE) return ModeId::NONE;
+    // 只有一个模式、由变体组成的主菜单项 (图片、字母、数字)
+    if (pgm_read_byte(&mode_table[(int)m.first].variants) > 1) {
+        variant = item;
+        return m.first;
+    }
+    return static_cast<ModeId>((int)m.first + item);
+}
+
+
+/******************************************************************************
+ *                               模式切换
+ ******************************************************************************/
+
+void mode_enter(ModeId id) {
+    mode_leave();
+    // 新模式从全零的内存池开始，不会看到上一个模式留下的数据
+    memset(mode_arena, 0, sizeof(mode_arena));
+    mode_active = id;
+    if (id == ModeId::NONE) return;
+    ModeDesc desc;
+    mode_get(id, desc);
+    if (desc.init) desc.init();
+}
+
+void mode_leave() {
+    if (mode_active == ModeId::NONE) return;
+    ModeDesc desc;
+    mode_get(mode_active, desc);
+    if (desc.exit) desc.exit();
+    // 整体释放：上一个模式申请的全部状态随之失效
+    arena_top = 0;
+    mode_active = ModeId::NONE;
+}
+
+ModeId mode_current() {
+    return mode_active;
+}
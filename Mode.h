@@ -0,0 +1,176 @@
+/**
+ * @file Mode.h
+ * @author 多嘴龙虾
+ * @brief 模式注册表：全屏动画、图片、游戏、字母和数字的统一描述与调度
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * 每个可运行的模式用一个描述符 (ModeDesc) 声明自己的初始化、按键、逐帧推进与绘制、
+ * 子菜单图标和帧率，所有描述符按 ModeId 编号存放在 PROGMEM 表中。
+ * 主菜单的每一项 (MainModeDesc) 则描述它包含哪些模式、左键如何切换以及主菜单图标。
+ * 调度只需按编号取出描述符后调用对应的钩子，增加模式不再需要修改多处 switch。
+ *
+ * 各模式的工作状态不再是常驻的全局变量，而是在进入模式时从模式内存池 (arena) 中申请：
+ * 池是一块静态缓冲区，按顺序分配 (bump)，切换模式时整体释放并清零。
+ * 池的大小取所有模式预算 (ModeDesc::arena_bytes) 的最大值，在编译期确定并检查上限。
+ */
+
+#ifndef _MODE_H_
+#define _MODE_H_
+
+#include "Device.h"
+
+/******************************************************************************
+ *                              模式编号与描述符
+ ******************************************************************************/
+
+/**
+ * @brief 可运行的模式，顺序与 ProfileMode 中 PROF_MODE_FLAME 之后的分类一致。
+ */
+enum class ModeId : uint8_t {
+    FLAME,
+    RAINBOW,
+    RAINBOW_HEART,
+    METEOR,
+    FIREWORKS,
+    RAIN,
+    SPARKS,
+    PIC,          // 6 张图片 (变体)
+    PINBALL,
+    SNAKE,
+    GAME_OF_LIFE,
+    LETTER,       // A-Z (变体)
+    NUMBER,       // 0-9 (变体)
+    COUNT,
+    NONE = COUNT  // 没有正在运行的模式
+};
+
+// --- 模式标志 ---
+const uint8_t MODE_RETAINED = 0x01; // 在上一帧画面的基础上继续绘制，render_frame() 不每帧清屏
+
+/**
+ * @brief 模式描述符。除 frame 外的钩子都可以为 NULL。
+ * @note 推进与绘制合为一个 frame 钩子：现有的模式都在同一遍里完成模拟和绘制
+ *       (火焰、粒子每个模拟步都在保留的画面上叠加绘制)。
+ */
+struct ModeDesc {
+    void (*init)(void);                  // 进入模式：从 (已清零的) 模式内存池申请并初始化状态
+    void (*exit)(void);                  // 离开模式：停止后台活动
+    void (*input)(KeyEvent event);       // 运行中的按键 (左键切换下一项由主菜单描述符统一处理)
+    void (*frame)(SYC_WS2812& ws, uint8_t variant, uint8_t sim_steps); // 推进 sim_steps 步并绘制一帧
+    void (*icon)(SYC_WS2812& ws);        // 子菜单中的预览图标
+    void (*invalidate)(void);            // 保留画面的模式：画面被清空后通知其整体重绘
+    uint8_t fps;                         // 目标帧率
+    uint8_t variants;                    // 左键切换的变体数 (图片、字母、数字)，无变体为 1
+    uint8_t flags;                       // MODE_* 标志
+    uint16_t arena_bytes;                // 模式内存池预算 (字节)，init 钩子申请的总量不能超过它
+};
+
+// --- 主菜单项标志 ---
+const uint8_t MAIN_SUB_MENU = 0x01; // 先进入子菜单预览、选择，右键确认后才开始运行
+const uint8_t MAIN_CYCLE    = 0x02; // 运行中左键切换到下一项
+
+/**
+ * @brief 主菜单项描述符。
+ * @details 第 i 项对应模式 first + i；只有一个模式且它有变体时，第 i 项为它的第 i 个变体。
+ */
+struct MainModeDesc {
+    void (*icon)(SYC_WS2812& ws);  // 主菜单图标
+    ModeId first;                  // 第一项对应的模式，NONE 表示不包含模式 (工具)
+    uint8_t count;                 // 项数
+    uint8_t flags;                 // MAIN_* 标志
+};
+
+/**
+ * @brief 读取模式描述符 (PROGMEM)。
+ */
+void mode_get(ModeId id, ModeDesc& desc);
+
+/**
+ * @brief 读取主菜单项描述符 (PROGMEM)。
+ */
+void main_mode_get(MainMode main, MainModeDesc& desc);
+
+/**
+ * @brief 把主菜单项中的第 item 项映射为模式和变体。
+ * @param variant 输出变体编号。
+ * @return 对应的模式；主菜单项不包含模式时返回 ModeId::NONE。
+ */
+ModeId main_mode_item(MainMode main, uint8_t item, uint8_t& variant);
+
+
+/******************************************************************************
+ *                              模式内存池 (Arena)
+ ******************************************************************************/
+
+/**
+ * @brief 内存池中每次分配的对齐字节数。
+ */
+const uint8_t MODE_ARENA_ALIGN = 8;
+
+/**
+ * @brief 把字节数向上取整到 MODE_ARENA_ALIGN 的倍数，用于在编译期计算各模式的预算。
+ */
+constexpr uint16_t mode_arena_round(size_t bytes) {
+    return (uint16_t)((bytes + MODE_ARENA_ALIGN - 1) & ~(size_t)(MODE_ARENA_ALIGN - 1));
+}
+
+/**
+ * @brief 从模式内存池中为当前模式申请一块已清零的内存，离开模式时整体释放。
+ * @return 内存池剩余空间不足时返回 NULL 并记录一次分配失败。
+ * @note 只能在模式的 init 钩子 (或之后) 调用；超出模式预算的分配仍会成功，但会被统计记录。
+ */
+void* mode_alloc(size_t bytes);
+
+/**
+ * @brief 为当前模式申请一个 T 类型的工作状态 (全零)。
+ * @note Mode.cpp 在编译期检查每个状态类型不超过其模式的预算，因此 init 钩子中的这次申请不会返回 NULL。
+ */
+template <typename T>
+T* mode_claim() {
+    return static_cast<T*>(mode_alloc(sizeof(T)));
+}
+
+/**
+ * @brief 模式内存池的容量 (字节)，即所有模式预算的最大值。
+ */
+uint16_t mode_arena_capacity(void);
+
+/**
+ * @brief 获取模式在描述符中声明的内存池预算 (字节)。
+ */
+uint16_t mode_arena_budget(ModeId id);
+
+/**
+ * @brief 获取模式运行以来在内存池中的最高用量 (字节)。
+ */
+uint16_t mode_arena_peak(ModeId id);
+
+/**
+ * @brief 获取因内存池空间不足而失败的分配次数。
+ */
+uint16_t mode_arena_failures(void);
+
+
+/******************************************************************************
+ *                                  当前模式
+ ******************************************************************************/
+
+/**
+ * @brief 进入一个模式：调用当前模式的 exit，释放并清零模式内存池，再调用新模式的 init。
+ * @note 即使 id 就是当前模式也会重新初始化 (例如从游戏子菜单的预览正式开始游戏)。
+ */
+void mode_enter(ModeId id);
+
+/**
+ * @brief 离开当前模式 (回到主菜单)。
+ */
+void mode_leave(void);
+
+/**
+ * @brief 获取当前模式。
+ */
+ModeId mode_current(void);
+
+#endif
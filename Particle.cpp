@@ -0,0 +1,279 @@
+/**
+ * @file Particle.cpp
+ * @author 多嘴龙虾
+ * @brief 通用粒子系统
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * 本文件实现了粒子池、发射器和粒子的积分与绘制：
+ * - 空闲粒子和存活粒子各自串成单向链表，链表指针存放在粒子内部，不额外占用内存。
+ * - 每个时间步先把 dt 换算成 Q0.16 秒，之后的积分只用乘法和移位。
+ * - 寿命进度用 16 位定点数表示，出生时算好每毫秒的增量，色带插值不需要除法。
+ */
+
+#include "Particle.h"
+#include "Mode.h"
+#include "Random.h"
+#include "Color.h"
+#include "Pixel.h"
+
+// 链表结束标记
+const uint8_t PARTICLE_NONE = 0xFF;
+
+// 粒子池与发射器，由 particles_enter() 从模式内存池申请
+static ParticleSystem* particles;
+
+// 一次连续发射的累加器阈值 (rate 为 Q8.8 粒子/秒，dt 单位为毫秒)
+const uint32_t PARTICLE_RATE_UNIT = 256UL * 1000;
+
+/**
+ * @brief 16 个方向的余弦值 (Q1.7)，正弦值为 cos(k - 4)。
+ */
+static const int8_t particle_dir_cos[16] PROGMEM = {
+    127, 117, 90, 49, 0, -49, -90, -117, -127, -117, -90, -49, 0, 49, 90, 117
+};
+
+/******************************************************************************
+ *                              粒子池
+ ******************************************************************************/
+
+void particles_enter(void) {
+    particles = mode_claim<ParticleSystem>();
+    particles_reset();
+}
+
+void particles_reset(void) {
+    for (uint8_t i = 0; i < PARTICLE_CAPACITY; i++) {
+        particles->pool[i].next = (i + 1 < PARTICLE_CAPACITY) ? i + 1 : PARTICLE_NONE;
+    }
+    particles->free_head = 0;
+    particles->live_head = PARTICLE_NONE;
+    particles->live_count = 0;
+    for (uint8_t e = 0; e < PARTICLE_MAX_EMITTERS; e++) {
+        particles->emitters[e].running = false;
+        particles->emitters[e].users = 0;
+    }
+}
+
+/**
+ * @brief 从空闲链表取出一个粒子并挂到存活链表头部。
+ * @return 粒子指针；粒子池已满时返回 NULL。
+ */
+static Particle* particle_alloc(uint8_t emitter) {
+    if (particles->free_head == PARTICLE_NONE) return NULL;
+    uint8_t i = particles->free_head;
+    Particle* p = &particles->pool[i];
+    particles->free_head = p->next;
+    p->next = particles->live_head;
+    particles->live_head = i;
+    p->emitter = emitter;
+    particles->live_count++;
+    particles->emitters[emitter].users++;
+    return p;
+}
+
+uint8_t particles_active_count(void) {
+    return particles->live_count;
+}
+
+/******************************************************************************
+ *                              发射器
+ ******************************************************************************/
+
+int8_t particle_emitter_start(const ParticleEmitterConfig* config) {
+    for (uint8_t e = 0; e < PARTICLE_MAX_EMITTERS; e++) {
+        ParticleEmitter& em = particles->emitters[e];
+        // 配置仍被存活粒子引用的发射器不能复用
+        if (em.running || em.users > 0) continue;
+        memcpy_P(&em.config, config, sizeof(ParticleEmitterConfig));
+        em.rate_acc = 0;
+        em.burst_timer = 0; // 启动后立即爆发一次
+        em.running = true;
+        return e;
+    }
+    return -1;
+}
+
+void particle_emitter_stop(int8_t emitter) {
+    if (emitter >= 0 && emitter < PARTICLE_MAX_EMITTERS) {
+        particles->emitters[emitter].running = false;
+    }
+}
+
+/**
+ * @brief 按发射器配置生成一个粒子。
+ * @param x, y 出生位置 (Q8.8)。
+ */
+static void particle_spawn(uint8_t emitter, int16_t x, int16_t y) {
+    Particle* p = particle_alloc(emitter);
+    if (p == NULL) return;
+    const ParticleEmitterConfig& c = particles->emitters[emitter].config;
+
+    p->x = x;
+    p->y = y;
+    p->vx = c.vx + rng_between(RNG_STREAM_PARTICLE, -c.vx_spread, c.vx_spread);
+    p->vy = c.vy + rng_between(RNG_STREAM_PARTICLE, -c.vy_spread, c.vy_spread);
+    if (c.flags & PARTICLE_RADIAL) {
+        uint8_t dir = rng_below(RNG_STREAM_PARTICLE, 16);
+        int32_t speed = rng_range(RNG_STREAM_PARTICLE, c.radial_min, c.radial_max);
+        p->vx += (int16_t)((speed * (int8_t)pgm_read_byte(&particle_dir_cos[dir])) >> 7);
+        p->vy += (int16_t)((speed * (int8_t)pgm_read_byte(&particle_dir_cos[(dir + 12) & 15])) >> 7);
+    }
+
+    // 寿命包含上限；配置颠倒时取下限
+    uint16_t life = (c.life_max_ms > c.life_min_ms)
+                  ? rng_between(RNG_STREAM_PARTICLE, c.life_min_ms, c.life_max_ms) : c.life_min_ms;
+    p->age = 0;
+    p->age_rate = 65535U / (life ? life : 1);
+    p->hue = c.hue + rng_below(RNG_STREAM_PARTICLE, (uint16_t)c.hue_spread + 1);
+}
+
+/**
+ * @brief 在出生区域内随机取一个坐标。
+ */
+static int16_t particle_random_in(int16_t lo, int16_t hi) {
+    return (hi > lo) ? rng_range(RNG_STREAM_PARTICLE, lo, hi) : lo;
+}
+
+/**
+ * @brief 推进发射器：连续发射和周期性爆发。
+ */
+static void particle_emitter_tick(uint8_t emitter, uint16_t dt_ms) {
+    ParticleEmitter& em = particles->emitters[emitter];
+    const ParticleEmitterConfig& c = em.config;
+
+    if (c.rate > 0) {
+        // 每次发射后扣除 0.5-1.5 个粒子的累加量，平均速率不变，但间隔不再完全均匀
+        em.rate_acc += (uint32_t)c.rate * dt_ms;
+        while (em.rate_acc >= PARTICLE_RATE_UNIT) {
+            uint32_t cost = PARTICLE_RATE_UNIT / 2 + rng_below(RNG_STREAM_PARTICLE, 256) * (PARTICLE_RATE_UNIT / 256);
+            em.rate_acc = (em.rate_acc > cost) ? em.rate_acc - cost : 0;
+            particle_spawn(emitter, particle_random_in(c.x_min, c.x_max), particle_random_in(c.y_min, c.y_max));
+        }
+    }
+
+    if (c.burst_interval_ms > 0) {
+        if (em.burst_timer > dt_ms) {
+            em.burst_timer -= dt_ms;
+        } else {
+            em.burst_timer = c.burst_interval_ms;
+            int16_t x = particle_random_in(c.x_min, c.x_max);
+            int16_t y = particle_random_in(c.y_min, c.y_max);
+            for (uint8_t i = 0; i < c.burst_count; i++) {
+                particle_spawn(emitter, x, y);
+            }
+        }
+    }
+}
+
+/******************************************************************************
+ *                              积分与回收
+ ******************************************************************************/
+
+void particles_update(uint16_t dt_ms) {
+    for (uint8_t e = 0; e < PARTICLE_MAX_EMITTERS; e++) {
+        if (particles->emitters[e].running) particle_emitter_tick(e, dt_ms);
+    }
+
+    // dt 换算为秒 (Q0.16)，每个时间步只做这一次除法
+    uint32_t dt_q16 = ((uint32_t)dt_ms * 65536UL + 500) / 1000;
+
+    // 每个发射器的速度增量和阻力系数在本时间步内对所有粒子相同
+    int16_t dv_gravity[PARTICLE_MAX_EMITTERS];
+    uint16_t drag_keep[PARTICLE_MAX_EMITTERS]; // 速度保留比例 (/256)
+    for (uint8_t e = 0; e < PARTICLE_MAX_EMITTERS; e++) {
+        const ParticleEmitterConfig& c = particles->emitters[e].config;
+        dv_gravity[e] = (int16_t)(((int32_t)c.gravity * (int32_t)dt_q16) >> 16);
+        uint32_t loss = ((uint32_t)c.drag * dt_q16) >> 16;
+        drag_keep[e] = (loss < 256) ? 256 - loss : 0;
+    }
+
+    uint8_t prev = PARTICLE_NONE;
+    uint8_t i = particles->live_head;
+    while (i != PARTICLE_NONE) {
+        Particle& p = particles->pool[i];
+        uint8_t next = p.next;
+        uint8_t e = p.emitter;
+
+        p.vy += dv_gravity[e];
+        if (drag_keep[e] != 256) {
+            p.vx = (int16_t)(((int32_t)p.vx * drag_keep[e]) >> 8);
+            p.vy = (int16_t)(((int32_t)p.vy * drag_keep[e]) >> 8);
+        }
+        int32_t x = p.x + (((int32_t)p.vx * (int32_t)dt_q16) >> 16);
+        int32_t y = p.y + (((int32_t)p.vy * (int32_t)dt_q16) >> 16);
+        uint32_t age = (uint32_t)p.age + (uint32_t)p.age_rate * dt_ms;
+
+        // 寿命耗尽，或离开屏幕 (左右和下方)；上方留出空间给向上飞的粒子落回
+        bool dead = age > 0xFFFF || x < -256 || x >= (8 << 8) || y >= (8 << 8) || y < -(8 << 8);
+        if (dead) {
+            // 从存活链表摘下，放回空闲链表
+            if (prev == PARTICLE_NONE) particles->live_head = next;
+            else particles->pool[prev].next = next;
+            p.next = particles->free_head;
+            particles->free_head = i;
+            particles->live_count--;
+            particles->emitters[e].users--;
+        } else {
+            p.x = (int16_t)x;
+            p.y = (int16_t)y;
+            p.age = (uint16_t)age;
+            prev = i;
+        }
+        i = next;
+    }
+}
+
+/******************************************************************************
+ *                                 绘制
+ ******************************************************************************/
+
+/**
+ * @brief 按寿命进度在色带上插值，得到粒子当前的颜色。
+ */
+static uint32_t particle_color(const Particle& p, const ParticleEmitterConfig& c) {
+    // 寿命进度映射到 3 段色带，seg 为段号，frac 为段内位置 (0-255)
+    uint16_t pos = (uint16_t)(((uint32_t)p.age * (PARTICLE_RAMP_STOPS - 1)) >> 8);
+    uint8_t seg = pos >> 8;
+    uint8_t frac = pos & 0xFF;
+    const ParticleRampStop& a = c.ramp[seg];
+    const ParticleRampStop& b = c.ramp[seg + 1];
+    int8_t  shift = a.hue_shift + (int8_t)(((b.hue_shift - a.hue_shift) * frac) >> 8);
+    uint8_t sat = a.sat + (((b.sat - a.sat) * frac) >> 8);
+    uint8_t val = a.val + (((b.val - a.val) * frac) >> 8);
+    return hsv_to_grb((uint16_t)(uint8_t)(p.hue + shift) << 8, sat, val);
+}
+
+/**
+ * @brief 把一个亚像素位置的颜色按双线性权重分摊到相邻的 4 个灯珠 (饱和叠加)。
+ */
+static void particle_splat(uint32_t* frame, int16_t x, int16_t y, uint32_t color) {
+    int8_t px = x >> 8;
+    int8_t py = y >> 8;
+    uint16_t fx = x & 0xFF;
+    uint16_t fy = y & 0xFF;
+    uint16_t wx[2] = {(uint16_t)(256 - fx), fx};
+    uint16_t wy[2] = {(uint16_t)(256 - fy), fy};
+
+    for (uint8_t dy = 0; dy < 2; dy++) {
+        int8_t cy = py + dy;
+        if (cy < 0 || cy >= 8 || wy[dy] == 0) continue;
+        for (uint8_t dx = 0; dx < 2; dx++) {
+            int8_t cx = px + dx;
+            if (cx < 0 || cx >= 8) continue;
+            uint16_t w = (wx[dx] * wy[dy]) >> 8; // 0-256
+            if (w == 0) continue;
+            uint8_t idx = cy * 8 + cx;
+            frame[idx] = px_add_sat(frame[idx], px_scale(color, w - 1));
+        }
+    }
+}
+
+void particles_render(SYC_WS2812& ws) {
+    for (uint8_t i = particles->live_head; i != PARTICLE_NONE; i = particles->pool[i].next) {
+        const Particle& p = particles->pool[i];
+        uint32_t color = particle_color(p, particles->emitters[p.emitter].config);
+        particle_splat(ws.led_data, p.x, p.y, color);
+    }
+}
@@ -0,0 +1,151 @@
+/**
+ * @file Particle.h
+ * @author 多嘴龙虾
+ * @brief 通用粒子系统
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * 此头文件定义了一个固定容量的粒子引擎：
+ * - 所有粒子共用一个固定容量的粒子池，空闲粒子串成空闲链表，生成和回收都是 O(1)。
+ *   粒子池从模式内存池 (Mode.h) 申请，只在粒子动画运行时占用内存。
+ * - 发射器按配置 (PROGMEM) 连续发射或周期性爆发粒子，可设置出生区域、速度和随机扩散。
+ * - 按毫秒时间步长做定点积分，支持重力和阻力，速度与帧率无关。
+ * - 粒子颜色随寿命沿 HSV 色带变化，绘制时按小数坐标把亮度分摊到相邻的 4 个灯珠。
+ * 流星雨、烟花、雨滴和火花都只是不同的发射器配置。
+ */
+
+#ifndef _PARTICLE_H_
+#define _PARTICLE_H_
+
+#include "Device.h"
+
+/**
+ * @brief 粒子池容量。每个粒子占用 14 字节 RAM。
+ */
+#ifndef PARTICLE_CAPACITY
+#define PARTICLE_CAPACITY 24
+#endif
+
+/**
+ * @brief 可同时运行的发射器数量。
+ */
+#ifndef PARTICLE_MAX_EMITTERS
+#define PARTICLE_MAX_EMITTERS 2
+#endif
+
+/**
+ * @brief 色带节点数，节点在粒子寿命内均匀分布。
+ */
+const uint8_t PARTICLE_RAMP_STOPS = 4;
+
+// --- 发射器标志 ---
+const uint8_t PARTICLE_RADIAL = 0x01; // 速度方向随机 (向四周散开)，大小在 [radial_min, radial_max) 内
+
+/**
+ * @brief 色带节点：相对粒子基础色相的偏移、饱和度和明度。
+ */
+struct ParticleRampStop {
+    int8_t  hue_shift;
+    uint8_t sat;
+    uint8_t val;
+};
+
+/**
+ * @brief 发射器配置。坐标单位为像素 (Q8.8)，速度单位为像素/秒 (Q8.8)。
+ */
+struct ParticleEmitterConfig {
+    uint16_t rate;              // 连续发射速率 (粒子/秒，Q8.8)，0 为不连续发射
+    uint16_t burst_interval_ms; // 爆发间隔，0 为不爆发
+    uint8_t  burst_count;       // 每次爆发的粒子数 (同一次爆发的粒子出生在同一点)
+    uint8_t  flags;
+    int16_t  x_min, x_max;      // 出生区域
+    int16_t  y_min, y_max;
+    int16_t  vx, vy;            // 基础速度
+    int16_t  vx_spread;         // 速度随机扩散 (±)
+    int16_t  vy_spread;
+    int16_t  radial_min;        // 径向发射的速度范围 (PARTICLE_RADIAL)
+    int16_t  radial_max;
+    int16_t  gravity;           // 重力加速度 (像素/秒²，Q8.8，向下为正)
+    uint8_t  drag;              // 阻力：每秒速度衰减的比例 (/256)
+    uint8_t  hue;               // 基础色相
+    uint8_t  hue_spread;        // 基础色相随机范围 [hue, hue + hue_spread]
+    uint16_t life_min_ms;       // 寿命范围
+    uint16_t life_max_ms;
+    ParticleRampStop ramp[PARTICLE_RAMP_STOPS]; // 寿命色带
+};
+
+/**
+ * @brief 单个粒子。
+ */
+struct Particle {
+    int16_t  x, y;      // 位置 (像素，Q8.8)
+    int16_t  vx, vy;    // 速度 (像素/秒，Q8.8)
+    uint16_t age;       // 寿命进度 (0 为出生，65535 为消亡)
+    uint16_t age_rate;  // 每毫秒增加的寿命进度
+    uint8_t  hue;       // 基础色相
+    uint8_t  emitter;   // 所属发射器，决定物理参数和色带
+    uint8_t  next;      // 链表中的下一个粒子
+};
+
+/**
+ * @brief 运行中的发射器 (配置的 RAM 副本 + 发射状态)。
+ */
+struct ParticleEmitter {
+    ParticleEmitterConfig config;
+    uint32_t rate_acc;     // 连续发射累加器 (单位: 粒子 * 256 * 毫秒)
+    uint16_t burst_timer;  // 距下一次爆发的时间 (单位: 毫秒)
+    bool     running;      // 是否仍在发射
+    uint8_t  users;        // 仍引用此配置的存活粒子数
+};
+
+/**
+ * @brief 粒子系统的全部工作状态。
+ */
+struct ParticleSystem {
+    Particle pool[PARTICLE_CAPACITY];
+    ParticleEmitter emitters[PARTICLE_MAX_EMITTERS];
+    uint8_t free_head;   // 空闲链表头
+    uint8_t live_head;   // 存活链表头
+    uint8_t live_count;  // 存活粒子数
+};
+
+/**
+ * @brief 从模式内存池申请粒子系统的状态并清空，其余函数都要在此之后调用。
+ */
+void particles_enter(void);
+
+/**
+ * @brief 清空粒子池并停止所有发射器。
+ */
+void particles_reset(void);
+
+/**
+ * @brief 启动一个发射器。
+ * @param config 发射器配置 (PROGMEM)，启动时复制到 RAM。
+ * @return 发射器编号；没有空闲发射器时返回 -1。
+ */
+int8_t particle_emitter_start(const ParticleEmitterConfig* config);
+
+/**
+ * @brief 停止发射器，已发射的粒子继续运动直到消亡。
+ */
+void particle_emitter_stop(int8_t emitter);
+
+/**
+ * @brief 推进一个时间步：发射新粒子，积分所有粒子的运动和寿命，回收消亡的粒子。
+ * @param dt_ms 时间步长 (单位: 毫秒)。
+ */
+void particles_update(uint16_t dt_ms);
+
+/**
+ * @brief 把所有粒子按亚像素位置叠加绘制到 led_data。
+ */
+void particles_render(SYC_WS2812& ws);
+
+/**
+ * @brief 当前存活的粒子数量。
+ */
+uint8_t particles_active_count(void);
+
+#endif
@@ -0,0 +1,49 @@
+/**
+ * @file Pixel.cpp
+ * @author 多嘴龙虾
+ * @brief 打包像素运算内核 (SWAR)
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * 本文件实现了整帧版本的像素内核，每个函数都是对帧缓冲区的单层循环。
+ */
+
+#include "Pixel.h"
+
+void frame_fade(uint32_t* frame, uint8_t count, uint8_t amount) {
+    uint32_t sub = px_splat(amount);
+    for (uint8_t i = 0; i < count; i++) {
+        frame[i] = px_sub_sat(frame[i], sub);
+    }
+}
+
+void frame_scale(uint32_t* frame, uint8_t count, uint8_t f) {
+    for (uint8_t i = 0; i < count; i++) {
+        frame[i] = px_scale(frame[i], f);
+    }
+}
+
+void frame_add_sat(uint32_t* dst, const uint32_t* src, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        dst[i] = px_add_sat(dst[i], src[i]);
+    }
+}
+
+void frame_sub_sat(uint32_t* dst, const uint32_t* src, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        dst[i] = px_sub_sat(dst[i], src[i]);
+    }
+}
+
+void frame_lerp(uint32_t* dst, const uint32_t* a, const uint32_t* b, uint8_t count, uint16_t t) {
+    for (uint8_t i = 0; i < count; i++) {
+        dst[i] = px_lerp(a[i], b[i], t);
+    }
+}
+
+void frame_max(uint32_t* dst, const uint32_t* src, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        dst[i] = px_max(dst[i], src[i]);
+    }
+}
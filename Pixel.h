@@ -0,0 +1,127 @@
+/**
+ * @file Pixel.h
+ * @author 多嘴龙虾
+ * @brief 打包像素运算内核 (SWAR)
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * 此头文件定义了直接作用于 32 位打包像素 (GRB，各占一个字节) 的运算内核：
+ * 饱和加/减、按 8 位系数缩放、两帧之间线性插值、逐通道取最大值。
+ * 加减法在 4 个字节上并行进行 (进位/借位不跨字节)；乘法类内核把像素拆成
+ * 偶数字节和奇数字节两组 16 位通道。一次运算处理整个像素，不需要逐通道拆包和重新打包。
+ * 整帧版本在一个循环里处理完整个帧缓冲区 (如 strip.led_data)。
+ */
+
+#ifndef _PIXEL_H_
+#define _PIXEL_H_
+
+#include <Arduino.h>
+
+/******************************************************************************
+ *                             单像素内核
+ ******************************************************************************/
+
+const uint32_t PX_LANE_LO  = 0x00FF00FFUL; // 每个 16 位通道的低字节
+const uint32_t PX_LANE_HI  = 0xFF00FF00UL; // 每个 16 位通道的高字节
+const uint32_t PX_BYTE_MSB = 0x80808080UL; // 每个字节的最高位
+
+/**
+ * @brief 把一个 8 位数复制到 G、R、B 三个通道。
+ */
+inline uint32_t px_splat(uint8_t v) {
+    return (uint32_t)v * 0x010101UL;
+}
+
+/**
+ * @brief 每个字节最高位上的标志扩展为整字节掩码 (0x80 -> 0xFF)。
+ */
+inline uint32_t px_msb_mask(uint32_t msb) {
+    return (msb << 1) - (msb >> 7);
+}
+
+/**
+ * @brief 逐通道饱和加法 min(a + b, 255)。
+ * @note 低 7 位相加后再单独补上最高位，进位不会跨字节；最高位的进位即为溢出标志。
+ */
+inline uint32_t px_add_sat(uint32_t a, uint32_t b) {
+    uint32_t sum = ((a & ~PX_BYTE_MSB) + (b & ~PX_BYTE_MSB)) ^ ((a ^ b) & PX_BYTE_MSB);
+    uint32_t carry = ((a & b) | ((a | b) & ~sum)) & PX_BYTE_MSB;
+    return sum | px_msb_mask(carry); // 溢出的通道置为 255
+}
+
+/**
+ * @brief 逐通道饱和减法 max(a - b, 0)。
+ * @note 先把被减数每个字节的最高位置 1 再相减，借位不会跨字节；最后修正最高位并找出借位的字节。
+ */
+inline uint32_t px_sub_sat(uint32_t a, uint32_t b) {
+    uint32_t diff = ((a | PX_BYTE_MSB) - (b & ~PX_BYTE_MSB)) ^ ((a ^ ~b) & PX_BYTE_MSB);
+    uint32_t borrow = ((~a & b) | (~(a ^ b) & diff)) & PX_BYTE_MSB;
+    return diff & ~px_msb_mask(borrow); // 不够减的通道置为 0
+}
+
+/**
+ * @brief 逐通道缩放 c * (f + 1) / 256，f = 255 时保持不变，f = 0 时接近黑色。
+ * @note 每个 16 位通道中 255 * 256 不会溢出，一次 32 位乘法处理两个通道。
+ */
+inline uint32_t px_scale(uint32_t c, uint8_t f) {
+    uint16_t k = (uint16_t)f + 1;
+    uint32_t e = (((c & PX_LANE_LO) * k) >> 8) & PX_LANE_LO;
+    uint32_t o = (((c >> 8) & PX_LANE_LO) * k) & PX_LANE_HI;
+    return e | o;
+}
+
+/**
+ * @brief 逐通道线性插值 a + (b - a) * t / 256。
+ * @param t 插值系数 (0 为 a，256 为 b)。
+ */
+inline uint32_t px_lerp(uint32_t a, uint32_t b, uint16_t t) {
+    uint16_t s = 256 - t;
+    uint32_t e = (((a & PX_LANE_LO) * s + (b & PX_LANE_LO) * t) >> 8) & PX_LANE_LO;
+    uint32_t o = (((a >> 8) & PX_LANE_LO) * s + ((b >> 8) & PX_LANE_LO) * t) & PX_LANE_HI;
+    return e | o;
+}
+
+/**
+ * @brief 逐通道取最大值。
+ * @note max(a, b) = b + max(a - b, 0)，相加不会产生跨通道进位。
+ */
+inline uint32_t px_max(uint32_t a, uint32_t b) {
+    return b + px_sub_sat(a, b);
+}
+
+/******************************************************************************
+ *                             整帧内核
+ ******************************************************************************/
+
+/**
+ * @brief 整帧淡出：每个通道减去 amount，最小为 0。
+ */
+void frame_fade(uint32_t* frame, uint8_t count, uint8_t amount);
+
+/**
+ * @brief 整帧按 8 位系数缩放亮度。
+ */
+void frame_scale(uint32_t* frame, uint8_t count, uint8_t f);
+
+/**
+ * @brief dst[i] = min(dst[i] + src[i], 255)，逐通道饱和叠加。
+ */
+void frame_add_sat(uint32_t* dst, const uint32_t* src, uint8_t count);
+
+/**
+ * @brief dst[i] = max(dst[i] - src[i], 0)，逐通道饱和相减。
+ */
+void frame_sub_sat(uint32_t* dst, const uint32_t* src, uint8_t count);
+
+/**
+ * @brief dst[i] = lerp(a[i], b[i], t)，两帧之间按 t / 256 过渡。dst 可以与 a 或 b 相同。
+ */
+void frame_lerp(uint32_t* dst, const uint32_t* a, const uint32_t* b, uint8_t count, uint16_t t);
+
+/**
+ * @brief dst[i] = max(dst[i], src[i])，逐通道取较亮者。
+ */
+void frame_max(uint32_t* dst, const uint32_t* src, uint8_t count);
+
+#endif
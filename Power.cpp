@@ -0,0 +1,192 @@
+/**
+ * @file Power.cpp
+ * @author 多嘴龙虾
+ * @brief 电源管理：帧间 WFI 空闲、无操作自动熄屏与深度睡眠、按键唤醒
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * 本文件实现了：
+ * - 帧间空闲：WFI 休眠到下一个 SysTick，按键中断可提前唤醒。
+ * - 无操作超时：淡出 -> 熄屏 -> STOP 深度睡眠 (关闭 SysTick，只由引脚中断唤醒)。
+ * - 唤醒：恢复时钟，重新对齐帧调度，吞掉用于唤醒的按键。
+ */
+
+#include "Power.h"
+#include "Scheduler.h"
+
+// STOP 唤醒后恢复系统时钟，由核心的 variant 提供
+extern "C" void SystemClock_Config(void);
+
+static PowerState power_state = PowerState::AWAKE;
+static uint32_t power_timeout_ms = POWER_IDLE_TIMEOUT_MS;
+static unsigned long power_last_activity = 0; // 最近一次按键 (或充电) 的时刻
+static unsigned long power_fade_start = 0;
+static bool power_swallow_keys = false;       // 按键正在用于唤醒，松开前忽略其事件
+static bool power_woke_flag = false;
+static volatile bool power_wake_request = false; // 充电引脚中断置位
+
+static PowerStats power_stats = {0, 0, 0};
+
+/**
+ * @brief 充电引脚中断：插拔充电器时唤醒，由 Voltage_task() 更新充电状态。
+ */
+static void power_wake_isr() {
+    power_wake_request = true;
+}
+
+void power_init() {
+    power_last_activity = millis();
+    attachInterrupt(digitalPinToInterrupt(CHRG_PIN), power_wake_isr, CHANGE);
+}
+
+void power_idle_us(uint32_t us) {
+    uint32_t start = micros();
+    // SysTick 每毫秒唤醒一次 WFI；不足 1ms 的尾巴用忙等补齐，保证帧调度的精度
+    while (!key_edge_pending() && (uint32_t)(micros() - start) + 1000 <= us) {
+        __WFI();
+    }
+    uint32_t spent = micros() - start;
+    if (spent < us && !key_edge_pending()) {
+        delayMicroseconds(us - spent);
+    }
+}
+
+/**
+ * @brief 熄灭所有灯珠。直接发送全黑帧，绕过帧差分。
+ */
+static void power_blank() {
+    strip.clearWs2812();
+    strip.Ws2812_show();
+    Ws2812_invalidate();
+}
+
+/**
+ * @brief 进入 STOP 深度睡眠，直到引脚中断唤醒。
+ * @note 须在关中断后调用 (见 power_task())，返回时中断已重新打开。
+ */
+static void power_deep_sleep() {
+    HAL_SuspendTick(); // SysTick 不再唤醒，只剩按键和充电引脚的 EXTI 中断
+    HAL_PWR_EnterSTOPMode(PWR_LOWPOWERREGULATOR_ON, PWR_STOPENTRY_WFI);
+    // 先恢复 SysTick 并开中断：时钟配置中等待振荡器、PLL 就绪的超时依赖 HAL_GetTick()，
+    // 在关中断或 SysTick 停止时调用会一直等下去
+    HAL_ResumeTick();
+    interrupts();
+    SystemClock_Config(); // STOP 唤醒后系统时钟回到 HSI，重新配置
+}
+
+/**
+ * @brief 是否有唤醒源：按键有边沿或仍被按住 (边沿可能已被 read_key_event() 取走)，或充电引脚变化。
+ */
+static bool power_wake_pending() {
+    return !key_all_released() || power_wake_request;
+}
+
+/**
+ * @brief 从淡出或睡眠中恢复正常运行。
+ * @param swallow 唤醒来自按键时为 true，松开前忽略其事件。
+ */
+static void power_wake(bool swallow) {
+    if (power_state == PowerState::SLEEPING) {
+        power_woke_flag = true;
+        power_stats.wakeups++;
+    }
+    power_state = PowerState::AWAKE;
+    power_swallow_keys = swallow;
+    power_wake_request = false;
+    power_last_activity = millis();
+}
+
+bool power_task() {
+    unsigned long now = millis();
+    // 充电时保持唤醒，显示充电状态
+    if (getCurrentChargingState() != STATE_DISCHARGING) power_last_activity = now;
+
+    switch (power_state) {
+        case PowerState::AWAKE:
+            if (!key_all_released()) power_last_activity = now; // 按键按住期间不计入无操作时间
+            if (power_timeout_ms != 0 && now - power_last_activity >= power_timeout_ms) {
+                power_state = PowerState::FADING;
+                power_fade_start = now;
+            }
+            return true;
+
+        case PowerState::FADING:
+            if (!key_all_released()) {
+                power_wake(true); // 按键打断淡出，这次按键不触发操作
+                return true;
+            }
+            if (now - power_last_activity < power_timeout_ms) {
+                power_state = PowerState::AWAKE; // 开始充电，取消淡出
+                return true;
+            }
+            if (now - power_fade_start < POWER_FADE_MS) return true;
+            power_blank();
+            power_wake_request = false; // 醒着时的充电引脚变化与这次睡眠无关
+            power_state = PowerState::SLEEPING;
+            power_stats.sleeps++;
+            return false;
+
+        case PowerState::SLEEPING:
+        default: {
+            // 关中断后再检查唤醒源：检查之后、进入 STOP 之前到来的中断仍会挂起并唤醒 WFI，
+            // 不会因为中断已经处理完而一直睡下去
+            noInterrupts();
+            if (power_wake_pending()) {
+                interrupts();
+            } else {
+                uint32_t start = micros();
+                power_deep_sleep(); // 返回时中断已打开
+                uint32_t slept = micros() - start;
+                power_stats.sleep_us += slept;
+                scheduler_resume(slept); // 睡眠时间计入空闲
+            }
+            // 其他中断 (或模拟器中的定时返回) 造成的唤醒：下一次循环继续睡
+            if (!power_wake_pending()) return false;
+
+            // 唤醒：SRAM 中的状态原样保留，重绘画面后继续运行
+            power_wake(!key_all_released());
+            return true;
+        }
+    }
+}
+
+bool power_filter_key(KeyEvent event) {
+    // 淡出中 (或睡眠中已被取走边沿) 的按键：恢复运行，这次按键不触发操作
+    if (power_state != PowerState::AWAKE) power_wake(true);
+    power_last_activity = millis();
+    if (!power_swallow_keys) return false;
+    // 松开是一次按键的最后一个事件，所有按键都松开后恢复正常
+    bool release = event == KeyEvent::LEFT_RELEASE || event == KeyEvent::RIGHT_RELEASE;
+    if (release && key_all_released()) power_swallow_keys = false;
+    return true;
+}
+
+uint8_t power_scale_brightness(uint8_t brightness) {
+    if (power_state != PowerState::FADING) return brightness;
+    unsigned long t = millis() - power_fade_start;
+    if (t >= POWER_FADE_MS) return 0;
+    return (uint8_t)((uint32_t)brightness * (POWER_FADE_MS - t) / POWER_FADE_MS);
+}
+
+bool power_woke() {
+    bool woke = power_woke_flag;
+    power_woke_flag = false;
+    return woke;
+}
+
+void power_set_timeout(uint32_t ms) {
+    power_timeout_ms = ms;
+}
+
+uint32_t power_get_timeout() {
+    return power_timeout_ms;
+}
+
+PowerState power_get_state() {
+    return power_state;
+}
+
+const PowerStats& get_power_stats() {
+    return power_stats;
+}
@@ -0,0 +1,106 @@
+/**
+ * @file Power.h
+ * @author 多嘴龙虾
+ * @brief 电源管理：帧间 WFI 空闲、无操作自动熄屏与深度睡眠、按键唤醒
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * 主循环在帧与帧之间用 WFI 让 CPU 停下，由 SysTick 或按键中断唤醒。
+ * 一段时间没有按键操作 (且未在充电) 后，画面在 POWER_FADE_MS 内淡出并熄灭，
+ * MCU 进入深度睡眠 (STOP)，只有按键或充电引脚的电平变化才能唤醒。
+ * 睡眠期间 SRAM 保持不变，唤醒后 AppState 和当前模式的状态原样继续运行；
+ * 用于唤醒 (或打断淡出) 的那一次按键不会触发任何操作。
+ */
+
+#ifndef _POWER_H_
+#define _POWER_H_
+
+#include "Device.h"
+
+/**
+ * @brief 无操作多久后自动熄屏睡眠 (单位: 毫秒)，0 表示从不睡眠。运行时可用 power_set_timeout() 修改。
+ */
+#ifndef POWER_IDLE_TIMEOUT_MS
+#define POWER_IDLE_TIMEOUT_MS 300000UL
+#endif
+
+/**
+ * @brief 熄屏前亮度淡出的时长 (单位: 毫秒)。
+ */
+const uint16_t POWER_FADE_MS = 1500;
+
+/**
+ * @brief 电源状态。
+ */
+enum class PowerState : uint8_t {
+    AWAKE,    // 正常运行
+    FADING,   // 超时后淡出中，任意按键恢复
+    SLEEPING  // 已熄屏，深度睡眠中
+};
+
+/**
+ * @brief 电源管理统计数据。
+ * @note 真机在 STOP 模式下 SysTick 停止计数，sleep_us 只在主机模拟中有意义。
+ */
+struct PowerStats {
+    uint32_t sleep_us; // 深度睡眠的累计时间
+    uint16_t sleeps;   // 进入深度睡眠的次数
+    uint16_t wakeups;  // 被按键或充电唤醒的次数
+};
+
+/**
+ * @brief 初始化电源管理，注册充电引脚的唤醒中断。应在 Key_Init()、Voltage_Init() 之后调用。
+ */
+void power_init(void);
+
+/**
+ * @brief 电源管理的周期性任务，应在主循环中每次调用。
+ * @details 处理超时淡出、熄屏和深度睡眠；睡眠时在函数内部进入 STOP，被唤醒后返回。
+ * @return 需要继续渲染时返回 true；睡眠中 (本次循环不渲染) 返回 false。
+ */
+bool power_task(void);
+
+/**
+ * @brief 帧间空闲：用 WFI 等待指定的时间，有按键边沿时提前返回。
+ * @param us 空闲时长 (单位: 微秒)。
+ */
+void power_idle_us(uint32_t us);
+
+/**
+ * @brief 记录一次按键操作，并判断该按键是否只用于唤醒。
+ * @return 按键用于唤醒或打断淡出时返回 true，调用者应忽略这个事件 (直到按键全部松开)。
+ */
+bool power_filter_key(KeyEvent event);
+
+/**
+ * @brief 按当前的淡出进度缩放亮度。
+ */
+uint8_t power_scale_brightness(uint8_t brightness);
+
+/**
+ * @brief 查询并清除“刚从睡眠中唤醒”的标志。唤醒后画面已被熄灭，需要整体重绘。
+ */
+bool power_woke(void);
+
+/**
+ * @brief 设置无操作自动睡眠的超时时间 (单位: 毫秒)，0 表示从不睡眠。
+ */
+void power_set_timeout(uint32_t ms);
+
+/**
+ * @brief 获取无操作自动睡眠的超时时间 (单位: 毫秒)。
+ */
+uint32_t power_get_timeout(void);
+
+/**
+ * @brief 获取当前电源状态。
+ */
+PowerState power_get_state(void);
+
+/**
+ * @brief 获取电源管理统计数据。
+ */
+const PowerStats& get_power_stats(void);
+
+#endif
@@ -0,0 +1,118 @@
+/**
+ * @file Profiler.cpp
+ * @author 多嘴龙虾
+ * @brief 分阶段帧耗时统计 (编译期可选)
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * 仅在 ENABLE_PROFILER=1 时编译。
+ */
+
+#include "Profiler.h"
+
+#if ENABLE_PROFILER
+
+// 直方图各桶的上限 (单位: 微秒)，最后一桶收纳所有更大的值
+static const uint16_t profile_bucket_limits[PROFILE_BUCKETS - 1] = {
+    100, 250, 500, 1000, 2000, 4000, 8000
+};
+
+static const char* const profile_stage_names[PROF_STAGE_COUNT] = {
+    "input", "render", "present", "voltage"
+};
+
+static const char* const profile_mode_names[PROF_MODE_COUNT] = {
+    "overlay", "menu", "flame", "rainbow", "heart", "meteor", "firework", "rain", "sparks",
+    "pic", "pinball", "snake", "life", "letter", "number"
+};
+
+static ProfileEntry profile_table[PROF_MODE_COUNT][PROF_STAGE_COUNT];
+static ProfileMode profile_mode = PROF_MODE_MENU;
+
+/**
+ * @brief 设置后续计时所归属的模式。
+ */
+void profiler_set_mode(ProfileMode mode) {
+    profile_mode = mode;
+}
+
+/**
+ * @brief 记录一次阶段耗时。
+ */
+void profiler_record(ProfileStage stage, uint32_t us) {
+    ProfileEntry& e = profile_table[profile_mode][stage];
+    uint16_t v = us > 0xFFFF ? 0xFFFF : (uint16_t)us;
+
+    // 滚动窗口：计数将满或某个桶将满时整体减半
+    uint8_t bucket = 0;
+    while (bucket < PROFILE_BUCKETS - 1 && v >= profile_bucket_limits[bucket]) bucket++;
+    if (e.count == 0xFFFF || e.hist[bucket] == 0xFF) {
+        e.count >>= 1;
+        e.sum_us >>= 1;
+        for (uint8_t i = 0; i < PROFILE_BUCKETS; i++) e.hist[i] >>= 1;
+    }
+
+    if (e.count == 0 || v < e.min_us) e.min_us = v;
+    if (v > e.max_us) e.max_us = v;
+    e.sum_us += v;
+    e.count++;
+    e.hist[bucket]++;
+}
+
+/**
+ * @brief 清零所有统计。
+ */
+void profiler_reset() {
+    memset(profile_table, 0, sizeof(profile_table));
+}
+
+/**
+ * @brief 通过串口输出统计表，只输出有数据的条目。
+ */
+void profiler_dump() {
+    Serial.println("mode stage count min avg max | <100 <250 <500 <1k <2k <4k <8k >=8k (us)");
+    for (uint8_t m = 0; m < PROF_MODE_COUNT; m++) {
+        for (uint8_t s = 0; s < PROF_STAGE_COUNT; s++) {
+            const ProfileEntry& e = profile_table[m][s];
+            if (e.count == 0) continue;
+            Serial.print(profile_mode_names[m]);
+            Serial.print(' ');
+            Serial.print(profile_stage_names[s]);
+            Serial.print(' ');
+            Serial.print((unsigned long)e.count);
+            Serial.print(' ');
+            Serial.print((unsigned long)e.min_us);
+            Serial.print(' ');
+            Serial.print((unsigned long)(e.sum_us / e.count));
+            Serial.print(' ');
+            Serial.print((unsigned long)e.max_us);
+            Serial.print(" |");
+            for (uint8_t i = 0; i < PROFILE_BUCKETS; i++) {
+                Serial.print(' ');
+                Serial.print((unsigned long)e.hist[i]);
+            }
+            Serial.println();
+        }
+    }
+}
+
+/**
+ * @brief 检查串口命令。
+ */
+void profiler_poll_serial() {
+    while (Serial.available() > 0) {
+        int c = Serial.read();
+        if (c == 'p') profiler_dump();
+        else if (c == 'r') profiler_reset();
+    }
+}
+
+/**
+ * @brief 获取指定 (模式, 阶段) 的统计。
+ */
+const ProfileEntry& profiler_entry(ProfileMode mode, ProfileStage stage) {
+    return profile_table[mode][stage];
+}
+
+#endif
@@ -0,0 +1,131 @@
+/**
+ * @file Profiler.h
+ * @author 多嘴龙虾
+ * @brief 分阶段帧耗时统计 (编译期可选)
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * 对主循环的各个阶段 (按键处理、帧渲染、亮度+发送、电源任务) 计时，
+ * 按模式分别记录 最小/平均/最大 耗时和一个分桶直方图，通过串口按需输出：
+ *   'p' - 输出统计表
+ *   'r' - 清零统计
+ *
+ * 只有定义 ENABLE_PROFILER=1 时才生效；默认关闭，此时所有 PROFILE_* 宏
+ * 展开为空，不占用任何 RAM/Flash。
+ */
+
+#ifndef _PROFILER_H_
+#define _PROFILER_H_
+
+#include <Arduino.h>
+
+#ifndef ENABLE_PROFILER
+#define ENABLE_PROFILER 0
+#endif
+
+/**
+ * @brief 计时时钟 (单位: 微秒)。主机模拟环境可替换为包含真实CPU时间的时钟。
+ */
+#ifndef PROFILER_CLOCK_US
+#define PROFILER_CLOCK_US() micros()
+#endif
+
+/**
+ * @brief 被计时的阶段。
+ */
+enum ProfileStage : uint8_t {
+    PROF_STAGE_INPUT,    // handle_input()
+    PROF_STAGE_RENDER,   // render_frame() 中当前模式的渲染分支
+    PROF_STAGE_PRESENT,  // setBrightness() + Ws2812_show()
+    PROF_STAGE_VOLTAGE,  // Voltage_task()
+    PROF_STAGE_COUNT
+};
+
+/**
+ * @brief 统计所归属的模式 (动画和游戏按子模式细分)。
+ */
+enum ProfileMode : uint8_t {
+    PROF_MODE_OVERLAY,
+    PROF_MODE_MENU,
+    PROF_MODE_FLAME,
+    PROF_MODE_RAINBOW,
+    PROF_MODE_RAINBOW_HEART,
+    PROF_MODE_METEOR,
+    PROF_MODE_FIREWORKS,
+    PROF_MODE_RAIN,
+    PROF_MODE_SPARKS,
+    PROF_MODE_PIC,
+    PROF_MODE_PINBALL,
+    PROF_MODE_SNAKE,
+    PROF_MODE_GAME_OF_LIFE,
+    PROF_MODE_LETTER,
+    PROF_MODE_NUMBER,
+    PROF_MODE_COUNT
+};
+
+/**
+ * @brief 直方图桶数，各桶上限见 Profiler.cpp 中的 profile_bucket_limits。
+ */
+const uint8_t PROFILE_BUCKETS = 8;
+
+#if ENABLE_PROFILER
+
+/**
+ * @brief 单个 (模式, 阶段) 的滚动统计。
+ * @details count 达到上限时 sum、count 和直方图一起减半，使平均值和分布
+ *          反映最近一段时间的情况。
+ */
+struct ProfileEntry {
+    uint16_t min_us;
+    uint16_t max_us;
+    uint32_t sum_us;
+    uint16_t count;
+    uint8_t hist[PROFILE_BUCKETS];
+};
+
+/**
+ * @brief 设置后续计时所归属的模式。
+ */
+void profiler_set_mode(ProfileMode mode);
+
+/**
+ * @brief 记录一次阶段耗时。
+ */
+void profiler_record(ProfileStage stage, uint32_t us);
+
+/**
+ * @brief 清零所有统计。
+ */
+void profiler_reset(void);
+
+/**
+ * @brief 通过串口输出统计表。
+ */
+void profiler_dump(void);
+
+/**
+ * @brief 检查串口命令 ('p' 输出, 'r' 清零)，应在主循环中调用。
+ */
+void profiler_poll_serial(void);
+
+/**
+ * @brief 获取指定 (模式, 阶段) 的统计。
+ */
+const ProfileEntry& profiler_entry(ProfileMode mode, ProfileStage stage);
+
+#define PROFILE_SET_MODE(mode)       profiler_set_mode(mode)
+#define PROFILE_BEGIN(var)           uint32_t var = PROFILER_CLOCK_US()
+#define PROFILE_END(var, stage)      profiler_record(stage, PROFILER_CLOCK_US() - (var))
+#define PROFILE_POLL_SERIAL()        profiler_poll_serial()
+
+#else
+
+#define PROFILE_SET_MODE(mode)       ((void)0)
+#define PROFILE_BEGIN(var)           ((void)0)
+#define PROFILE_END(var, stage)      ((void)0)
+#define PROFILE_POLL_SERIAL()        ((void)0)
+
+#endif
+
+#endif
@@ -0,0 +1,113 @@
+/**
+ * @file Random.cpp
+ * @author 多嘴龙虾
+ * @brief 快速、可设定种子的伪随机数子系统
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * 本文件实现了随机流的播种和批量生成：
+ * - 主种子经过混合函数派生出各随机流的初始状态。
+ * - 上电时从电池采样引脚的 ADC 噪声收集熵。
+ * - 批量字节生成按 16 位通道并行缩放，不需要除法。
+ */
+
+#include "Random.h"
+
+// 初值与 rng_seed(0) 相同：rng_init() 之前的调用也能得到非零的随机序列 (xorshift 的状态为 0 时永远输出 0)
+uint32_t rng_state[RNG_STREAM_COUNT] = {0x92CA2F0EUL, 0x3CD6E3F3UL, 0x1B147DCCUL, 0x4C081DBFUL};
+static_assert(RNG_STREAM_COUNT == 4, "增加随机流时需要补充 rng_state 的初值");
+
+static uint32_t rng_master_seed = 0;
+
+/**
+ * @brief 32 位混合函数 (murmur3 fmix32)，使相邻的种子派生出差异很大的状态。
+ */
+static uint32_t rng_mix32(uint32_t x) {
+    x ^= x >> 16;
+    x *= 0x85EBCA6BUL;
+    x ^= x >> 13;
+    x *= 0xC2B2AE35UL;
+    x ^= x >> 16;
+    return x;
+}
+
+/**
+ * @brief 用主种子初始化所有随机流。
+ */
+void rng_seed(uint32_t seed) {
+    rng_master_seed = seed;
+    for (uint8_t i = 0; i < RNG_STREAM_COUNT; i++) {
+        uint32_t x = rng_mix32(seed + 0x9E3779B9UL * (i + 1));
+        rng_state[i] = x ? x : 0x6D2B79F5UL; // xorshift 的状态不能为 0
+    }
+}
+
+/**
+ * @brief 从 ADC 采样噪声收集种子。
+ * @note 每次采样只有最低几位是噪声，多次采样后循环移位累积，再做一次混合。
+ */
+static uint32_t rng_seed_from_adc(void) {
+    uint32_t seed = 0;
+    for (uint8_t i = 0; i < 32; i++) {
+        seed = (seed << 5 | seed >> 27) ^ (uint32_t)analogRead(ADC_PIN);
+        delayMicroseconds(50); // 让两次采样之间的噪声不相关
+    }
+    seed ^= micros();
+    return rng_mix32(seed);
+}
+
+/**
+ * @brief 上电初始化随机数子系统。
+ */
+void rng_init(void) {
+#if RNG_FIXED_SEED
+    rng_seed(RNG_FIXED_SEED);
+#else
+    rng_seed(rng_seed_from_adc());
+#endif
+}
+
+uint32_t rng_get_seed(void) {
+    return rng_master_seed;
+}
+
+/**
+ * @brief 批量生成随机字节，每次生成 4 个字节。
+ */
+void rng_fill(RandomStream s, uint8_t* buf, uint16_t len) {
+    while (len >= 4) {
+        uint32_t x = rng_next(s);
+        buf[0] = (uint8_t)x;
+        buf[1] = (uint8_t)(x >> 8);
+        buf[2] = (uint8_t)(x >> 16);
+        buf[3] = (uint8_t)(x >> 24);
+        buf += 4;
+        len -= 4;
+    }
+    if (len > 0) {
+        uint32_t x = rng_next(s);
+        while (len--) {
+            *buf++ = (uint8_t)x;
+            x >>= 8;
+        }
+    }
+}
+
+/**
+ * @brief 把 4 个随机字节各自缩放到 [0, range)。
+ * @note 偶数字节和奇数字节分别放在 16 位通道里与 range 相乘 (255*256 不会溢出通道)，
+ *       再取每个通道的高字节，一次 32 位乘法处理两个值。
+ */
+static uint32_t rng_scale_bytes(uint32_t x, uint16_t range) {
+    const uint32_t LANE_LO = 0x00FF00FFUL;
+    uint32_t even = ((x & LANE_LO) * range >> 8) & LANE_LO;
+    uint32_t odd  = (((x >> 8) & LANE_LO) * range) & ~LANE_LO;
+    return even | odd;
+}
+
+uint64_t rng_bytes_below(RandomStream s, uint16_t range) {
+    uint32_t lo = rng_scale_bytes(rng_next(s), range);
+    uint32_t hi = rng_scale_bytes(rng_next(s), range);
+    return ((uint64_t)hi << 32) | lo;
+}
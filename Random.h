@@ -0,0 +1,108 @@
+/**
+ * @file Random.h
+ * @author 多嘴龙虾
+ * @brief 快速、可设定种子的伪随机数子系统
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * 此头文件定义了替代 Arduino random() 的随机数接口。每个子系统使用独立的
+ * 随机流 (xorshift32)，互不干扰；有界取值用乘法+移位代替取模 (Cortex-M0+
+ * 没有硬件除法)，并提供批量字节生成。
+ * 上电时从 ADC_PIN 的采样噪声取种子；定义 RNG_FIXED_SEED 后改用固定种子，
+ * 便于确定性回放和跨版本的逐帧对比。
+ */
+
+#ifndef _RANDOM_H_
+#define _RANDOM_H_
+
+#include "Device.h"
+
+/**
+ * @brief 固定种子。定义为非零值后不再从 ADC 取种子，每次上电的随机序列完全相同。
+ */
+#ifndef RNG_FIXED_SEED
+#define RNG_FIXED_SEED 0
+#endif
+
+/**
+ * @brief 随机流，每个子系统一个，各自的序列只由主种子决定，与其他子系统的调用次数无关。
+ */
+enum RandomStream : uint8_t {
+    RNG_STREAM_FLAME,    // 火焰动画
+    RNG_STREAM_PARTICLE, // 粒子系统 (流星雨、烟花等)
+    RNG_STREAM_LIFE,     // 生命游戏
+    RNG_STREAM_SNAKE,    // 贪吃蛇
+    RNG_STREAM_COUNT
+};
+
+/**
+ * @brief 各随机流的状态 (xorshift32，永不为 0)。
+ */
+extern uint32_t rng_state[RNG_STREAM_COUNT];
+
+/**
+ * @brief 用主种子初始化所有随机流。
+ * @param seed 主种子，相同的种子产生完全相同的序列。
+ */
+void rng_seed(uint32_t seed);
+
+/**
+ * @brief 上电初始化：RNG_FIXED_SEED 非零时使用固定种子，否则从 ADC 噪声取种子。
+ * @note 需在 Voltage_Init() 配置好 ADC 之后调用。
+ */
+void rng_init(void);
+
+/**
+ * @brief 获取当前使用的主种子 (用于记录和回放)。
+ */
+uint32_t rng_get_seed(void);
+
+/**
+ * @brief 生成下一个 32 位随机数。
+ */
+inline uint32_t rng_next(RandomStream s) {
+    uint32_t x = rng_state[s];
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    rng_state[s] = x;
+    return x;
+}
+
+/**
+ * @brief 生成 [0, range) 内的随机数，用高 16 位乘法缩放代替取模。
+ */
+inline uint16_t rng_below(RandomStream s, uint16_t range) {
+    return (uint16_t)(((rng_next(s) >> 16) * range) >> 16);
+}
+
+/**
+ * @brief 生成 [lo, hi) 内的随机数 (与 random(lo, hi) 含义相同，要求 hi - lo <= 65535)。
+ */
+inline int32_t rng_range(RandomStream s, int32_t lo, int32_t hi) {
+    return lo + rng_below(s, (uint16_t)(hi - lo));
+}
+
+/**
+ * @brief 生成 [lo, hi] 内的随机数 (包含 hi，要求 0 <= hi - lo <= 65535)。
+ * @details 区间长度最大为 65536，(rng_next >> 16) * span 不超过 32 位，
+ *          因此整个 uint16_t 范围 (如 [0, 65535]) 也能取到，不会回绕成空区间。
+ */
+inline int32_t rng_between(RandomStream s, int32_t lo, int32_t hi) {
+    uint32_t span = (uint32_t)(hi - lo) + 1;
+    return lo + (int32_t)(((rng_next(s) >> 16) * span) >> 16);
+}
+
+/**
+ * @brief 批量生成随机字节。
+ */
+void rng_fill(RandomStream s, uint8_t* buf, uint16_t len);
+
+/**
+ * @brief 一次生成 8 个 [0, range) 内的随机字节，打包为 64 位 (字节 i 为第 i 个值)。
+ * @param range 取值范围 (1-256)。
+ */
+uint64_t rng_bytes_below(RandomStream s, uint16_t range);
+
+#endif
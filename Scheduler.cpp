@@ -0,0 +1,102 @@
+/**
+ * @file Scheduler.cpp
+ * @author 多嘴龙虾
+ * @brief 固定时间步长的帧调度器
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * 本文件实现了主循环的帧调度：
+ * - 根据目标帧率计算固定时间步长。
+ * - 落后时一次返回多个模拟步 (追帧)，严重落后时丢弃多余的步数。
+ * - 未到下一帧时以 WFI 空闲一小段时间，降低CPU占空比。
+ */
+
+#include "Scheduler.h"
+#include "Power.h"
+
+// 当前使用的时间步长 (单位: 微秒)，0 表示需要重新对齐
+static uint32_t sched_step_us = 0;
+// 上一个已消耗的时间步的时刻
+static uint32_t sched_last_step_us = 0;
+
+static SchedulerStats sched_stats = {0, 0, 0, 0, 0};
+
+/**
+ * @brief 空闲指定的时间。
+ * @param us 空闲时长 (单位: 微秒)。
+ */
+static void scheduler_idle(uint32_t us) {
+    uint32_t start = micros();
+    power_idle_us(us);
+    sched_stats.idle_us += micros() - start;
+}
+
+/**
+ * @brief 按目标帧率推进帧调度。
+ */
+uint8_t scheduler_poll(uint8_t target_fps) {
+    if (target_fps == 0) target_fps = 1;
+    uint32_t now = micros();
+    uint32_t step_us = 1000000UL / target_fps;
+
+    // 帧率变化 (切换模式) 时重新对齐，立即输出一帧
+    if (step_us != sched_step_us) {
+        sched_step_us = step_us;
+        sched_last_step_us = now - step_us;
+    }
+
+    uint32_t elapsed = now - sched_last_step_us;
+    if (elapsed < step_us) {
+        uint32_t remaining = step_us - elapsed;
+        scheduler_idle(remaining < SCHEDULER_IDLE_SLICE_US ? remaining : SCHEDULER_IDLE_SLICE_US);
+        return 0;
+    }
+
+    uint32_t steps = elapsed / step_us;
+    if (steps > SCHEDULER_MAX_CATCHUP_STEPS) {
+        // 落后太多 (例如长时间阻塞)，丢弃多余的步数并对齐到当前时刻
+        sched_stats.dropped_steps += steps - SCHEDULER_MAX_CATCHUP_STEPS;
+        steps = SCHEDULER_MAX_CATCHUP_STEPS;
+        sched_last_step_us = now;
+    } else {
+        sched_last_step_us += steps * step_us;
+    }
+
+    sched_stats.frames++;
+    sched_stats.sim_steps += steps;
+    return (uint8_t)steps;
+}
+
+/**
+ * @brief 重新对齐调度时钟，并清零统计。
+ */
+void scheduler_reset() {
+    sched_step_us = 0;
+    sched_stats = {0, 0, 0, 0, (uint32_t)micros()};
+}
+
+/**
+ * @brief 从睡眠中恢复。
+ */
+void scheduler_resume(uint32_t slept_us) {
+    sched_step_us = 0;
+    sched_stats.idle_us += slept_us;
+}
+
+/**
+ * @brief 获取调度器运行统计。
+ */
+const SchedulerStats& get_scheduler_stats() {
+    return sched_stats;
+}
+
+/**
+ * @brief 计算统计区间内的CPU占空比 (千分比)。
+ */
+uint16_t scheduler_duty_permille() {
+    uint32_t total = micros() - sched_stats.start_us;
+    if (total == 0) return 1000;
+    uint32_t idle = sched_stats.idle_us > total ? total : sched_stats.idle_us;
+    return (uint16_t)(((uint64_t)(total - idle) * 1000) / total);
+}
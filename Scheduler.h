@@ -0,0 +1,70 @@
+/**
+ * @file Scheduler.h
+ * @author 多嘴龙虾
+ * @brief 固定时间步长的帧调度器
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * 此头文件定义了主循环使用的帧调度接口。每个模式声明自己的目标帧率，
+ * 调度器按固定时间步长推进模拟 (落后时自动追帧)，并在帧与帧之间空闲，
+ * 使动画速度与CPU负载无关。时间统一取自 micros()，在主机模拟环境中
+ * 可由模拟时钟替换。
+ */
+
+#ifndef _SCHEDULER_H_
+#define _SCHEDULER_H_
+
+#include "Device.h"
+
+/**
+ * @brief 单帧内最多追赶的模拟步数，超过的步数直接丢弃，防止越追越慢。
+ */
+const uint8_t SCHEDULER_MAX_CATCHUP_STEPS = 4;
+
+/**
+ * @brief 一次空闲的最长时间 (单位: 微秒)。
+ * @note 空闲期间 CPU 以 WFI 休眠，按键中断会提前结束空闲；切成小片是为了让后台任务按时运行。
+ */
+const uint32_t SCHEDULER_IDLE_SLICE_US = 4000;
+
+/**
+ * @brief 调度器运行统计。
+ */
+struct SchedulerStats {
+    uint32_t frames;        // 已调度的帧数
+    uint32_t sim_steps;     // 已执行的模拟步数 (含追帧)
+    uint32_t dropped_steps; // 因落后太多而丢弃的模拟步数
+    uint32_t idle_us;       // 累计空闲时间
+    uint32_t start_us;      // 统计起始时刻
+};
+
+/**
+ * @brief 按目标帧率推进帧调度，应在主循环中反复调用。
+ * @param target_fps 当前模式的目标帧率 (1-255)。
+ * @return 本帧需要执行的模拟步数；0 表示本帧时间未到 (此时已空闲一小段时间)。
+ */
+uint8_t scheduler_poll(uint8_t target_fps);
+
+/**
+ * @brief 重新对齐调度时钟，下一次 scheduler_poll() 立即产生一帧。
+ */
+void scheduler_reset(void);
+
+/**
+ * @brief 从睡眠中恢复：重新对齐调度时钟 (不追赶睡眠期间的帧)，睡眠时间计入空闲。
+ * @param slept_us 睡眠时长 (单位: 微秒)。
+ */
+void scheduler_resume(uint32_t slept_us);
+
+/**
+ * @brief 获取调度器运行统计。
+ */
+const SchedulerStats& get_scheduler_stats(void);
+
+/**
+ * @brief 计算统计区间内的CPU占空比 (千分比，0-1000)。
+ */
+uint16_t scheduler_duty_permille(void);
+
+#endif
@@ -21,6 +21,17 @@
 4、循环调度层
 
     WS2812_Keychain.ino
+    Scheduler.cpp/Scheduler.h   // 帧调度 (固定时间步长)
+    Profiler.cpp/Profiler.h     // 分阶段耗时统计 (编译期可选)
+    Power.cpp/Power.h           // 电源管理 (帧间 WFI、无操作自动睡眠)
+
+5、公共算法
+
+    Bitboard.cpp/Bitboard.h     // 64 位位棋盘
+    Random.cpp/Random.h         // 伪随机数 (分子系统的随机流)
+    Color.cpp/Color.h           // 定点 HSV 颜色引擎
+    Pixel.cpp/Pixel.h           // 打包像素运算内核
+    Particle.cpp/Particle.h     // 通用粒子系统
 
 */
 
@@ -32,15 +43,35 @@ void setup() {
     WS2812_Init();
     Key_Init();
     Voltage_Init();
+    // ADC 配置好之后再取随机种子
+    rng_init();
+    power_init();
+    scheduler_reset();
 }
 
 void loop() {
-    // 1. 处理用户输入，更新状态
+    // 0. 串口命令：输出/清零性能统计 (仅 ENABLE_PROFILER=1 时生效)
+    PROFILE_POLL_SERIAL();
+
+    // 1. 处理用户输入，更新状态 (耗时计入按键发生时所在的模式)
+    PROFILE_SET_MODE(profile_mode_of_state());
+    PROFILE_BEGIN(input_t0);
     handle_input();
+    PROFILE_END(input_t0, PROF_STAGE_INPUT);
+    // 之后的渲染、发送和电压检测计入输入处理后的模式 (切换模式后的第一帧即计入新模式)
+    PROFILE_SET_MODE(profile_mode_of_state());
+
+    // 2. 电源管理：无操作超时后淡出、熄屏并深度睡眠，睡眠中不渲染
+    if (!power_task()) return;
 
-    // 2. 根据更新后的状态，渲染一帧 (现在是打印信息)
-    render_frame();
+    // 3. 按当前模式的目标帧率调度，时间到了才渲染一帧，否则空闲一小段时间
+    uint8_t sim_steps = scheduler_poll(get_target_fps());
+    if (sim_steps > 0) {
+        render_frame(sim_steps);
+    }
 
-    // 3. 处理后台任务 (如电压检测)
+    // 4. 处理后台任务 (如电压检测)
+    PROFILE_BEGIN(voltage_t0);
     Voltage_task();
+    PROFILE_END(voltage_t0, PROF_STAGE_VOLTAGE);
 }
\ No newline at end of file
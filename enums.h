@@ -15,72 +15,10 @@ enum class MainMode {
     SYSTEM_OVERLAY 
 };
 
-// 卡通人物模式
-enum class PicMode {
-    CAT,
-    PEACH,
-    HEART,
-    DARK,
-    SWORD,
-    DOG
-};
-
-enum class LetterMode {
-    Letter_A,
-    Letter_B,
-    Letter_C,
-    Letter_D,
-    Letter_E,
-    Letter_F,
-    Letter_G,
-    Letter_H,
-    Letter_I,
-    Letter_J,
-    Letter_K,
-    Letter_L,
-    Letter_M,
-    Letter_N,
-    Letter_O,
-    Letter_P,
-    Letter_Q,
-    Letter_R,
-    Letter_S,
-    Letter_T,
-    Letter_U,
-    Letter_V,
-    Letter_W,
-    Letter_X,
-    Letter_Y,
-    Letter_Z
-};
-
-enum class NumberMode {
-    Number_0,
-    Number_1,
-    Number_2,
-    Number_3,
-    Number_4,
-    Number_5,
-    Number_6,
-    Number_7,
-    Number_8,
-    Number_9
-};
+// 主菜单项的数量 (不含覆盖层)
+const uint8_t MAIN_MODE_COUNT = (uint8_t)MainMode::SYSTEM_OVERLAY;
 
-// 动画子模式
-enum class AnimMode {
-    FLAME,
-    RAINBOW,
-    RAINBOW_HEART,
-    METEOR
-};
-
-// 游戏子模式
-enum class GameMode {
-    PINBALL,
-    SNAKE,
-    GAME_OF_LIFE
-};
+// 动画、图片、游戏、字母、数字各自包含的模式见模式注册表 (Mode.h)
 
 // 工具子模式
 enum class ToolMode {
@@ -103,8 +41,16 @@ enum class KeyEvent {
     LEFT_CLICK,
     LEFT_LONG_PRESS,
     RIGHT_CLICK, 
-    RIGHT_LONG_PRESS, 
-    BOTH_PRESS
+    RIGHT_LONG_PRESS,      // 右键是组合键的修饰键，长按在松开时产生
+    BOTH_PRESS,            // 两键几乎同时按下
+    LEFT_DOUBLE_CLICK,     // 紧跟在第二次 LEFT_CLICK 之后
+    RIGHT_DOUBLE_CLICK,
+    LEFT_REPEAT,           // 长按后继续按住，按逐渐缩短的间隔重复
+    RIGHT_REPEAT,          // 右键的长按在松开时产生，当前不会出现
+    LEFT_RELEASE,          // 每次松开都会产生，是一次按键的最后一个事件
+    RIGHT_RELEASE,
+    LEFT_HOLD_RIGHT_CLICK, // 组合键：按住左键时单击右键
+    RIGHT_HOLD_LEFT_CLICK  // 组合键：按住右键时单击左键
 };
 /**
  * @brief 电池电量等级 (4档)
@@ -127,11 +73,7 @@ enum ChargingState {
 
 struct AppState {
     MainMode main_mode;
-    AnimMode anim_mode;
-    PicMode pic_mode;
-    GameMode game_mode;
-    LetterMode letter_mode;
-    NumberMode number_mode;
+    uint8_t item[MAIN_MODE_COUNT]; // 各主菜单项当前选中的项 (动画、图片、游戏、字母、数字)
     ToolMode tool_mode;
     SystemOverlayMode overlay_mode;
 
@@ -141,15 +83,6 @@ struct AppState {
     uint8_t brightness_level;
 };
 
-// 流星结构体
-struct Meteor {
-    int16_t x;           // 定点数坐标 (Q8.8: 8位整数, 8位小数)
-    int16_t y;
-    int16_t speed;
-    uint8_t hue;
-    bool is_active;
-};
-
 // 使用 extern 关键字进行声明
 extern AppState appState;
 
@@ -0,0 +1,54 @@
+/**
+ * @file arena_test.cpp
+ * @author 多嘴龙虾
+ * @brief 主机测试：检查每个模式在模式内存池中的实际用量不超过它声明的预算
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * 依次进入每个模式 (包括重新进入) 并运行若干帧，统计 init 钩子及运行中的全部申请，
+ * 打印各模式的预算、实际用量和状态结构体的大小。
+ * 任一模式超出预算或有分配失败时返回 1，make test 随之失败。
+ */
+
+#include <stdio.h>
+#include "../manage.h"
+
+static const char* const mode_names[] = {
+    "FLAME", "RAINBOW", "HEART", "METEOR", "FIREWORKS", "RAIN", "SPARKS",
+    "PIC", "PINBALL", "SNAKE", "LIFE", "LETTER", "NUMBER"
+};
+static_assert(sizeof(mode_names) / sizeof(mode_names[0]) == (int)ModeId::COUNT, "mode_names 必须与 ModeId 一一对应");
+
+int main() {
+    rng_seed(0x5EED1234UL);
+    for (int i = 0; i < (int)ModeId::COUNT; i++) {
+        ModeDesc desc;
+        mode_get((ModeId)i, desc);
+        // 进入两次：第二次从已释放的内存池重新申请
+        for (int pass = 0; pass < 2; pass++) {
+            mode_enter((ModeId)i);
+            for (uint8_t v = 0; v < desc.variants; v++) {
+                for (int f = 0; f < 50; f++) desc.frame(strip, v, 1);
+            }
+        }
+        mode_leave();
+    }
+
+    bool ok = mode_arena_failures() == 0;
+    printf("模式内存池: 容量 %u 字节\n", (unsigned)mode_arena_capacity());
+    printf("%-10s %8s %8s\n", "mode", "budget", "peak");
+    for (int i = 0; i < (int)ModeId::COUNT; i++) {
+        uint16_t budget = mode_arena_budget((ModeId)i);
+        uint16_t peak = mode_arena_peak((ModeId)i);
+        bool over = peak > budget;
+        printf("%-10s %8u %8u%s\n", mode_names[i], (unsigned)budget, (unsigned)peak, over ? "  超出预算!" : "");
+        if (over) ok = false;
+    }
+    printf("状态结构体: FlameState %u, ParticleSystem %u, PinballData %u, SnakeData %u, LifeData %u 字节\n",
+           (unsigned)sizeof(FlameState), (unsigned)sizeof(ParticleSystem), (unsigned)sizeof(PinballData),
+           (unsigned)sizeof(SnakeData), (unsigned)sizeof(LifeData));
+    if (mode_arena_failures()) printf("分配失败: %u 次\n", (unsigned)mode_arena_failures());
+    printf("%s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : 1;
+}
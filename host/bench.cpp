@@ -0,0 +1,374 @@
+/**
+ * @file bench.cpp
+ * @author 多嘴龙虾
+ * @brief 主机基准测试：对比各个内核优化前后的单帧耗时
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * 每个基准包含优化前的参考实现 (legacy) 和固件中的当前实现，在主机上
+ * 重复运行并输出每次调用的平均耗时。主机比目标MCU快得多，应关注两者的比值。
+ *
+ * 用法: bench [名称...]   不带参数时运行全部基准
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <algorithm>
+#include <vector>
+#include "../manage.h"
+
+/**
+ * @brief 主机单调时钟 (单位: 纳秒)。
+ */
+static double now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/**
+ * @brief 重复调用 fn，返回每次调用的平均耗时 (纳秒)。
+ */
+template <typename F>
+static double time_per_call(F fn, int iterations) {
+    for (int i = 0; i < iterations / 10; i++) fn(); // 预热
+    double start = now_ns();
+    for (int i = 0; i < iterations; i++) fn();
+    return (now_ns() - start) / iterations;
+}
+
+/**
+ * @brief 重复 runs 轮 time_per_call()，取中位数，减小主机调度和频率变化的干扰。
+ */
+template <typename F>
+static double median_time_per_call(F fn, int iterations, int runs) {
+    std::vector<double> samples;
+    for (int r = 0; r < runs; r++) samples.push_back(time_per_call(fn, iterations));
+    std::sort(samples.begin(), samples.end());
+    return samples[runs / 2];
+}
+
+static void report(const char* label, double ns, double baseline_ns) {
+    printf("  %-36s %10.1f ns/帧", label, ns);
+    if (baseline_ns > 0) printf("   x%.2f", baseline_ns / ns);
+    printf("\n");
+}
+
+/******************************************************************************
+ *                              火焰动画
+ ******************************************************************************/
+
+// 优化前的火焰实现：逐像素 map() 取色，单缓冲原地扩散，每像素 4 次带边界检查的读取和一次除法
+static uint32_t legacy_heat_to_color(byte temperature) {
+    if (temperature == 0) return 0;
+    uint8_t r, g, b;
+    if (temperature <= 85) {
+        r = map(temperature, 0, 85, 0, 180); g = 0; b = 0;
+    } else if (temperature <= 170) {
+        r = map(temperature, 86, 170, 180, 255); g = map(temperature, 86, 170, 0, 100); b = 0;
+    } else {
+        r = 255; g = map(temperature, 171, 255, 100, 255); b = 0;
+    }
+    return ((uint32_t)g << 16) | ((uint32_t)r << 8) | (uint32_t)b;
+}
+
+static void legacy_flame(SYC_WS2812& ws, int cooling, int sparking, bool reversed) {
+    const int WIDTH = 8;
+    const int HEIGHT = 8;
+    static uint8_t heat[ws2812_number];
+
+    for (int i = 0; i < ws2812_number; i++) {
+        int cooldown = random(0, ((cooling * 10) / HEIGHT) + 2);
+        heat[i] = (heat[i] > cooldown) ? (heat[i] - cooldown) : 0;
+    }
+    for (int y = 0; y < HEIGHT; y++) {
+        for (int x = 0; x < WIDTH; x++) {
+            int current_idx = reversed ? (HEIGHT - 1 - y) * WIDTH + x : y * WIDTH + x;
+            int heat_down_left  = (y < HEIGHT - 1 && x > 0)       ? heat[(y+1)*WIDTH + (x-1)] : 0;
+            int heat_down       = (y < HEIGHT - 1)                ? heat[(y+1)*WIDTH + x]     : 0;
+            int heat_down_right = (y < HEIGHT - 1 && x < WIDTH-1) ? heat[(y+1)*WIDTH + (x+1)] : 0;
+            int heat_further_down = (y < HEIGHT - 2)              ? heat[(y+2)*WIDTH + x]     : 0;
+            heat[current_idx] = (heat_down * 3 + heat_down_left + heat_down_right + heat_further_down) / 6;
+        }
+    }
+    if (random(255) < sparking) {
+        int x = random(1, WIDTH - 2);
+        int y = reversed ? 0 : HEIGHT - 1;
+        heat[y * WIDTH + x] = random(160, 255);
+    }
+    for (int i = 0; i < ws2812_number; i++) {
+        ws.setWs2812Color(i, legacy_heat_to_color(heat[i]));
+    }
+}
+
+static void bench_flame() {
+    const int N = 200000;
+    printf("flame: flameEffect_lowRam(cooling=30, sparking=200)\n");
+    mode_enter(ModeId::FLAME); // 火焰的热度图从模式内存池申请
+    double legacy = time_per_call([] { legacy_flame(strip, 30, 200, false); }, N);
+    double current = time_per_call([] { flameEffect_lowRam(strip, 30, 200, false); }, N);
+    report("legacy (map 取色 + 逐像素扩散)", legacy, 0);
+    report("current (调色板 + SWAR 双缓冲)", current, legacy);
+}
+
+/******************************************************************************
+ *                               彩虹动画
+ ******************************************************************************/
+
+// 优化前的彩虹流动：每个像素独立调用 Wheel()
+static void legacy_rainbow_flow(SYC_WS2812& ws, uint8_t speed, uint8_t density) {
+    uint32_t time_component = millis() / (100 / speed);
+    for (int i = 0; i < ws2812_number; i++) {
+        byte hue = (i * density + time_component) & 255;
+        ws.setWs2812Color(i, ws.Wheel(hue));
+    }
+}
+
+static void bench_rainbow() {
+    const int N = 200000;
+    printf("rainbow: anim_rainbow_flow(speed=20, density=2)\n");
+    double legacy = time_per_call([] { legacy_rainbow_flow(strip, 20, 2); }, N);
+    double current = time_per_call([] { anim_rainbow_flow(strip, 20, 2); }, N);
+    double dimmed = time_per_call([] { hsv_fill(strip, 0, ws2812_number, 0, 2 << 8, 200, 128); }, N);
+    report("legacy (逐像素 Wheel)", legacy, 0);
+    report("current (hsv_fill 批量查表)", current, legacy);
+    report("hsv_fill (sat=200, val=128)", dimmed, legacy);
+}
+
+/******************************************************************************
+ *                             像素运算内核
+ ******************************************************************************/
+
+// 优化前的流星拖尾淡出：逐像素拆成三个通道分别做饱和减法再重新打包
+static void legacy_fade(uint32_t* frame, uint8_t amount) {
+    for (int i = 0; i < ws2812_number; i++) {
+        uint32_t color = frame[i];
+        uint8_t r = (color >> 16) & 0xFF;
+        uint8_t g = (color >> 8) & 0xFF;
+        uint8_t b = color & 0xFF;
+        r = (r <= amount) ? 0 : r - amount;
+        g = (g <= amount) ? 0 : g - amount;
+        b = (b <= amount) ? 0 : b - amount;
+        frame[i] = ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
+    }
+}
+
+static uint32_t bench_frame_a[ws2812_number];
+static uint32_t bench_frame_b[ws2812_number];
+static uint32_t bench_source_a[ws2812_number];
+static uint32_t bench_source_b[ws2812_number];
+
+// 每次调用前从随机画面复制一份，避免淡出到全黑后测到的是特殊情况
+static void refill_frames() {
+    memcpy(bench_frame_a, bench_source_a, sizeof(bench_frame_a));
+    memcpy(bench_frame_b, bench_source_b, sizeof(bench_frame_b));
+}
+
+static void bench_pixel() {
+    const int N = 200000;
+    printf("pixel: 整帧 64 像素\n");
+    for (int i = 0; i < ws2812_number; i++) {
+        bench_source_a[i] = rng_next(RNG_STREAM_PARTICLE) & 0xFFFFFF;
+        bench_source_b[i] = rng_next(RNG_STREAM_PARTICLE) & 0xFFFFFF;
+    }
+    double refill = time_per_call([] { refill_frames(); }, N);
+    double legacy = time_per_call([] { refill_frames(); legacy_fade(bench_frame_a, FADE_RATE); }, N) - refill;
+    double fade = time_per_call([] { refill_frames(); frame_fade(bench_frame_a, ws2812_number, FADE_RATE); }, N) - refill;
+    double add = time_per_call([] { refill_frames(); frame_add_sat(bench_frame_a, bench_frame_b, ws2812_number); }, N) - refill;
+    double scale = time_per_call([] { refill_frames(); frame_scale(bench_frame_a, ws2812_number, 100); }, N) - refill;
+    double lerp = time_per_call([] { refill_frames(); frame_lerp(bench_frame_a, bench_frame_a, bench_frame_b, ws2812_number, 96); }, N) - refill;
+    double max = time_per_call([] { refill_frames(); frame_max(bench_frame_a, bench_frame_b, ws2812_number); }, N) - refill;
+    report("legacy 淡出 (逐通道拆包)", legacy, 0);
+    report("frame_fade", fade, legacy);
+    report("frame_add_sat", add, 0);
+    report("frame_scale", scale, 0);
+    report("frame_lerp", lerp, 0);
+    report("frame_max", max, 0);
+}
+
+/******************************************************************************
+ *                               生命游戏
+ ******************************************************************************/
+
+// 优化前的生命游戏演化：逐格调用 countNeighbors()，每次查询都经过边界检查
+static Bitboard legacy_world;
+
+static int legacy_cell(int x, int y) {
+    if (x < 0 || x >= 8 || y < 0 || y >= 8) return 0;
+    return (legacy_world >> (y * 8 + x)) & 1;
+}
+
+static int legacy_count_neighbors(int x, int y) {
+    int count = 0;
+    for (int i = -1; i <= 1; i++) {
+        for (int j = -1; j <= 1; j++) {
+            if (i == 0 && j == 0) continue;
+            count += legacy_cell(x + i, y + j);
+        }
+    }
+    return count;
+}
+
+static __attribute__((noinline)) void legacy_life_step() {
+    Bitboard next_world = 0;
+    for (int x = 0; x < 8; x++) {
+        for (int y = 0; y < 8; y++) {
+            int neighbors = legacy_count_neighbors(x, y);
+            int current_state = legacy_cell(x, y);
+            if ((current_state == 1 && (neighbors == 2 || neighbors == 3)) ||
+                (current_state == 0 && neighbors == 3)) {
+                next_world |= bb_bit(x, y);
+            }
+        }
+    }
+    legacy_world = next_world;
+}
+
+static const LifeRule conway_rule = {1 << 3, (1 << 2) | (1 << 3)};
+
+static void bench_life() {
+    const int N = 200000;
+    printf("life: 生命游戏演化一代\n");
+
+    // 先在随机世界上逐代比对两种实现 (8x8 世界，每行一个字节)
+    // 自己播种：不依赖 main() 和其他测试，单独运行 "bench life" 时也是非空的随机世界
+    rng_seed(0x5EED1234UL);
+    int mismatches = 0;
+    for (int i = 0; i < 2000; i++) {
+        Bitboard seed = ((Bitboard)rng_next(RNG_STREAM_LIFE) << 32) | rng_next(RNG_STREAM_LIFE);
+        legacy_world = seed;
+        uint32_t rows[8];
+        for (int y = 0; y < 8; y++) rows[y] = (uint8_t)(seed >> (y * 8));
+        for (int g = 0; g < 8; g++) {
+            legacy_life_step();
+            life_universe_step(rows, 8, 8, conway_rule, false);
+            for (int y = 0; y < 8; y++) {
+                if (rows[y] != (uint8_t)(legacy_world >> (y * 8))) { mismatches++; break; }
+            }
+        }
+    }
+    printf("  与逐格实现比对 16000 代，不一致 %d 代\n", mismatches);
+
+    Bitboard start = 0x0000183C3C180000ULL | 0x8100000000000081ULL;
+    double legacy = median_time_per_call([start] { legacy_world = start; legacy_life_step(); }, N, 15);
+    report("legacy 8x8 (逐格数邻居)", legacy, 0);
+
+    // 不同大小的世界：同一个约 20% 密度的随机世界反复演化一代。
+    // 每个大小取 15 轮的中位数，并扣除每次复制初始世界的时间，只比较演化本身
+    static const uint8_t sizes[] = {8, 16, 24, 32};
+    for (uint8_t size : sizes) {
+        uint32_t seed_rows[32] = {0};
+        for (int i = 0; i < size * size / 5; i++) {
+            seed_rows[rng_below(RNG_STREAM_LIFE, size)] |= 1UL << rng_below(RNG_STREAM_LIFE, size);
+        }
+        uint32_t rows[32];
+        double copy = median_time_per_call([&] { memcpy(rows, seed_rows, sizeof(rows)); }, N, 15);
+        double ns = median_time_per_call([&] {
+            memcpy(rows, seed_rows, sizeof(rows));
+            life_universe_step(rows, size, size, conway_rule, true);
+        }, N, 15) - copy;
+        char label[48];
+        snprintf(label, sizeof(label), "universe %ux%u (%.1f ns/行)", size, size, ns / size);
+        report(label, ns, legacy);
+    }
+}
+
+/******************************************************************************
+ *                          贪吃蛇自动驾驶
+ ******************************************************************************/
+
+static void bench_snake() {
+    const int GAMES = 2000;
+    const int MAX_STEPS = 64 * 64 * 2; // 超过这个步数仍未结束，视为绕圈
+    printf("snake: 自动驾驶连续玩 %d 局 (每一步含寻路)\n", GAMES);
+
+    int wins = 0, deaths = 0, loops = 0;
+    long total_steps = 0, total_length = 0;
+    double total_ns = 0;
+    std::vector<float> step_ns; // 每一步的耗时，用来取分位数 (最大值受主机调度干扰太大)
+    mode_enter(ModeId::SNAKE); // 从模式内存池申请贪吃蛇状态，之后每局由 snake_init() 重置
+    for (int g = 0; g < GAMES; g++) {
+        snake_init();
+        snake_set_autopilot(true);
+        int steps = 0;
+        while (snake_get_state() == SnakeState::RUNNING && steps < MAX_STEPS) {
+            double start = now_ns();
+            snake_step();
+            double ns = now_ns() - start;
+            total_ns += ns;
+            step_ns.push_back((float)ns);
+            steps++;
+        }
+        total_steps += steps;
+        total_length += snake_get_length();
+        if (snake_get_state() == SnakeState::WON) wins++;
+        else if (snake_get_state() == SnakeState::GAME_OVER) deaths++;
+        else loops++;
+    }
+    printf("  占满棋盘 %d 局，撞死 %d 局，绕圈超时 %d 局，平均结束长度 %.1f，平均 %.0f 步/局\n",
+           wins, deaths, loops, (double)total_length / GAMES, (double)total_steps / GAMES);
+    printf("  %-36s %10.1f ns/步\n", "平均每步", total_ns / total_steps);
+    std::sort(step_ns.begin(), step_ns.end());
+    printf("  %-36s %10.1f ns/步\n", "99% 分位", step_ns[step_ns.size() * 99 / 100]);
+}
+
+/******************************************************************************
+ *                               随机数
+ ******************************************************************************/
+
+static volatile uint32_t bench_sink;
+
+static void bench_rng() {
+    const int N = 2000000;
+    printf("rng: 64 个 [0, 40) 内的随机数 (一帧火焰冷却的用量)\n");
+    double legacy = time_per_call([] {
+        uint32_t acc = 0;
+        for (int i = 0; i < 64; i++) acc += random(0, 40);
+        bench_sink = acc;
+    }, N / 64);
+    double scalar = time_per_call([] {
+        uint32_t acc = 0;
+        for (int i = 0; i < 64; i++) acc += rng_below(RNG_STREAM_FLAME, 40);
+        bench_sink = acc;
+    }, N / 64);
+    double bulk = time_per_call([] {
+        uint64_t acc = 0;
+        for (int i = 0; i < 8; i++) acc ^= rng_bytes_below(RNG_STREAM_FLAME, 40);
+        bench_sink = (uint32_t)acc;
+    }, N / 64);
+    report("legacy random(lo, hi)", legacy, 0);
+    report("rng_below", scalar, legacy);
+    report("rng_bytes_below (8 个一组)", bulk, legacy);
+}
+
+/******************************************************************************
+ *                                 入口
+ ******************************************************************************/
+
+struct BenchEntry {
+    const char* name;
+    void (*run)(void);
+};
+
+static const BenchEntry benches[] = {
+    {"flame", bench_flame},
+    {"rng",   bench_rng},
+    {"rainbow", bench_rainbow},
+    {"pixel", bench_pixel},
+    {"life",  bench_life},
+    {"snake", bench_snake},
+};
+
+int main(int argc, char** argv) {
+    rng_seed(0x5EED1234UL); // 固定种子：每次运行使用相同的随机世界与输入
+    for (const BenchEntry& b : benches) {
+        bool selected = (argc <= 1);
+        for (int i = 1; i < argc; i++) {
+            if (strcmp(argv[i], b.name) == 0) selected = true;
+        }
+        if (selected) b.run();
+    }
+    return 0;
+}
@@ -0,0 +1,247 @@
+/**
+ * @file sim_main.cpp
+ * @author 多嘴龙虾
+ * @brief 主机模拟器入口：无界面运行真实的 setup()/loop()
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * 模拟器按照预设的按键脚本遍历所有模式 (动画、图片、三个游戏、字母、数字、
+ * 亮度设置、电量显示、充电、无操作自动睡眠与按键唤醒)，运行结束后输出帧差分、
+ * 帧调度和电源管理 (WFI 空闲与深度睡眠换算的占空比) 的统计数据，
+ * 并检查每个模式在模式内存池中的最高用量没有超出它声明的预算 (超出时返回 1)。
+ * 时间完全由模拟时钟驱动，运行速度远快于实时。
+ *
+ * 用法: sim [-v] [-s 种子] [遍历次数]
+ *   -v  每个脚本步骤后打印当前状态
+ *   -s  上电后改用指定的随机种子 (默认使用 ADC 噪声种子)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "../manage.h"
+
+void setup(void);
+void loop(void);
+
+/**
+ * @brief 每次 loop() 迭代额外计入的固定开销 (单位: 微秒)，近似主循环本身的CPU时间。
+ */
+const uint32_t SIM_LOOP_OVERHEAD_US = 20;
+
+// 按键脚本动作
+enum SimAction {
+    SIM_WAIT,
+    SIM_CLICK_LEFT,
+    SIM_CLICK_RIGHT,
+    SIM_LONG_LEFT,
+    SIM_LONG_RIGHT,
+    SIM_BOTH,
+    SIM_HOLD_LEFT,   // 按住左键 3 秒 (自动重复加速滚动)
+    SIM_CHORD_RIGHT, // 按住右键时单击左键 (上一项)
+    SIM_CHARGE_ON,
+    SIM_CHARGE_OFF
+};
+
+struct SimStep {
+    uint32_t wait_ms;  // 执行动作前运行的时间
+    SimAction action;
+};
+
+// 遍历全部模式的按键脚本 (左键=下一个，右键=进入/确认，右键长按=返回)
+static const SimStep tour[] = {
+    {1000, SIM_CLICK_RIGHT},                                          // 动画: 火焰
+    {3000, SIM_CLICK_LEFT}, {3000, SIM_CLICK_LEFT},                   // 彩虹、彩虹爱心
+    {3000, SIM_CLICK_LEFT}, {3000, SIM_CLICK_LEFT},                   // 流星雨、烟花
+    {3000, SIM_CLICK_LEFT}, {3000, SIM_CLICK_LEFT},                   // 雨滴、火花
+    {3000, SIM_CLICK_LEFT}, {500, SIM_LONG_RIGHT},                    // 回到火焰，返回
+    {500, SIM_CLICK_LEFT}, {1000, SIM_CLICK_RIGHT},                   // 图片
+    {1000, SIM_CLICK_LEFT}, {1000, SIM_CLICK_LEFT}, {1000, SIM_CLICK_LEFT},
+    {1000, SIM_CLICK_LEFT}, {1000, SIM_CLICK_LEFT}, {1000, SIM_LONG_RIGHT},
+    {500, SIM_CLICK_LEFT}, {1000, SIM_CLICK_RIGHT},                   // 游戏子菜单: 弹珠图标
+    {2000, SIM_CLICK_RIGHT},                                          // 开始弹珠
+    {900, SIM_CLICK_LEFT}, {900, SIM_CLICK_RIGHT}, {900, SIM_CLICK_RIGHT},
+    {3000, SIM_LONG_RIGHT},
+    {500, SIM_CLICK_RIGHT}, {500, SIM_CLICK_LEFT},                    // 贪吃蛇图标
+    {2000, SIM_CLICK_RIGHT},                                          // 开始贪吃蛇
+    {700, SIM_CLICK_LEFT}, {700, SIM_CLICK_LEFT}, {700, SIM_CLICK_RIGHT},
+    {3000, SIM_LONG_RIGHT},
+    {500, SIM_CLICK_RIGHT}, {500, SIM_CLICK_LEFT},                    // 生命游戏图标
+    {2000, SIM_CLICK_RIGHT}, {5000, SIM_LONG_RIGHT},                  // 生命游戏
+    {500, SIM_CLICK_LEFT}, {1000, SIM_CLICK_RIGHT},                   // 字母
+    {500, SIM_CLICK_LEFT}, {500, SIM_HOLD_LEFT}, {500, SIM_CHORD_RIGHT}, {1000, SIM_LONG_RIGHT}, // 按住滚动、组合键退回
+    {500, SIM_CLICK_LEFT}, {1000, SIM_CLICK_RIGHT},                   // 数字
+    {500, SIM_CLICK_LEFT}, {500, SIM_CLICK_LEFT}, {1000, SIM_LONG_RIGHT},
+    {500, SIM_CLICK_LEFT}, {1000, SIM_CLICK_RIGHT},                   // 工具: 亮度设置
+    {500, SIM_CLICK_LEFT}, {500, SIM_CLICK_LEFT}, {500, SIM_CLICK_RIGHT},
+    {1000, SIM_BOTH}, {3000, SIM_CHARGE_ON}, {4000, SIM_CHARGE_OFF},  // 电量、充电
+    {1000, SIM_CLICK_LEFT}, {1000, SIM_WAIT},                         // 回到动画主图标
+    {POWER_IDLE_TIMEOUT_MS + 30000, SIM_CLICK_RIGHT}, {2000, SIM_WAIT}, // 超时熄屏睡眠，按键唤醒 (不进入)
+};
+
+static const char* const main_mode_names[] = {
+    "ANIMATION", "PIC", "GAME", "LETTER", "NUMBER", "TOOL", "OVERLAY"
+};
+
+/**
+ * @brief 运行固件指定的模拟时间。
+ */
+static void run_for(uint32_t ms) {
+    uint64_t end = sim_time_us() + (uint64_t)ms * 1000;
+    while (sim_time_us() < end) {
+        loop();
+        sim_advance_us(SIM_LOOP_OVERHEAD_US);
+    }
+}
+
+/**
+ * @brief 按住指定按键一段时间后松开。
+ */
+static void press(bool left, bool right, uint32_t hold_ms) {
+    uint64_t release_at = sim_time_us() + (uint64_t)hold_ms * 1000;
+    if (left) {
+        sim_set_pin(LEFT_KEY_PIN, LOW);
+        sim_set_pin_at(LEFT_KEY_PIN, HIGH, release_at);
+    }
+    if (right) {
+        sim_set_pin(RIGHT_KEY_PIN, LOW);
+        sim_set_pin_at(RIGHT_KEY_PIN, HIGH, release_at);
+    }
+    run_for(hold_ms);
+}
+
+static void perform(SimAction action) {
+    switch (action) {
+        case SIM_WAIT:        break;
+        case SIM_CLICK_LEFT:  press(true, false, 80); break;
+        case SIM_CLICK_RIGHT: press(false, true, 80); break;
+        case SIM_LONG_LEFT:   press(true, false, 1000); break;
+        case SIM_LONG_RIGHT:  press(false, true, 1000); break;
+        case SIM_BOTH:        press(true, true, 200); break;
+        case SIM_HOLD_LEFT:   press(true, false, 3000); break;
+        case SIM_CHORD_RIGHT:
+            sim_set_pin(RIGHT_KEY_PIN, LOW);
+            sim_set_pin_at(RIGHT_KEY_PIN, HIGH, sim_time_us() + 400000);
+            run_for(150);
+            press(true, false, 80);
+            run_for(170);
+            break;
+        case SIM_CHARGE_ON:   sim_set_pin(CHRG_PIN, LOW); break;
+        case SIM_CHARGE_OFF:  sim_set_pin(CHRG_PIN, HIGH); break;
+    }
+}
+
+static void print_report(double wall_s) {
+    double sim_s = sim_time_us() / 1e6;
+
+    printf("\n==== 帧差分发送统计 ====\n");
+    printf("%-10s %8s %8s %7s %12s\n", "mode", "frames", "skipped", "skip%", "pixels_sent");
+    for (int i = 0; i <= (int)MainMode::SYSTEM_OVERLAY; i++) {
+        const ShowStats& s = getShowStats((MainMode)i);
+        double pct = s.frames ? 100.0 * s.skipped / s.frames : 0.0;
+        printf("%-10s %8u %8u %6.1f%% %12u\n", main_mode_names[i],
+               (unsigned)s.frames, (unsigned)s.skipped, pct, (unsigned)s.pixels_sent);
+    }
+    printf("Ws2812_show 调用: %u 次, 发送耗时 %.3f s (%.1f%% 模拟时间)\n",
+           (unsigned)strip.sim_show_count, strip.sim_tx_us / 1e6,
+           sim_s > 0 ? 100.0 * strip.sim_tx_us / 1e6 / sim_s : 0.0);
+
+    const SchedulerStats& st = get_scheduler_stats();
+    printf("\n==== 帧调度统计 ====\n");
+    printf("frames %u, sim_steps %u, dropped %u, duty %.1f%%\n",
+           (unsigned)st.frames, (unsigned)st.sim_steps, (unsigned)st.dropped_steps,
+           scheduler_duty_permille() / 10.0);
+
+    // 深度睡眠计入空闲；醒着时的占空比只统计未睡眠的时间
+    const PowerStats& ps = get_power_stats();
+    double total_s = (micros() - st.start_us) / 1e6;
+    double busy_s = total_s - st.idle_us / 1e6;
+    double awake_s = total_s - ps.sleep_us / 1e6;
+    printf("\n==== 电源管理 ====\n");
+    printf("睡眠 %u 次, 唤醒 %u 次, 深度睡眠 %.1f s (%.1f%% 模拟时间)\n",
+           (unsigned)ps.sleeps, (unsigned)ps.wakeups, ps.sleep_us / 1e6,
+           total_s > 0 ? 100.0 * ps.sleep_us / 1e6 / total_s : 0.0);
+    printf("CPU 占空比: 醒着时 %.1f%%, 全程 %.1f%%\n",
+           awake_s > 0 ? 100.0 * busy_s / awake_s : 0.0, total_s > 0 ? 100.0 * busy_s / total_s : 0.0);
+    if (key_event_dropped()) printf("按键事件队列溢出: 丢弃 %u 个事件\n", (unsigned)key_event_dropped());
+
+    printf("\n模拟时间 %.1f s, 实际耗时 %.3f s, 加速比 %.0fx\n",
+           sim_s, wall_s, wall_s > 0 ? sim_s / wall_s : 0.0);
+}
+
+static const char* const mode_names[] = {
+    "FLAME", "RAINBOW", "HEART", "METEOR", "FIREWORKS", "RAIN", "SPARKS",
+    "PIC", "PINBALL", "SNAKE", "LIFE", "LETTER", "NUMBER"
+};
+static_assert(sizeof(mode_names) / sizeof(mode_names[0]) == (int)ModeId::COUNT, "mode_names 必须与 ModeId 一一对应");
+
+/**
+ * @brief 打印模式内存池的用量，并检查每个模式都没有超出预算。
+ * @return 所有模式都在预算内且没有分配失败时返回 true。
+ */
+static bool check_mode_arena(void) {
+    bool ok = mode_arena_failures() == 0;
+    printf("\n==== 模式内存池 (容量 %u 字节) ====\n", (unsigned)mode_arena_capacity());
+    printf("%-10s %8s %8s\n", "mode", "budget", "peak");
+    for (int i = 0; i < (int)ModeId::COUNT; i++) {
+        uint16_t budget = mode_arena_budget((ModeId)i);
+        uint16_t peak = mode_arena_peak((ModeId)i);
+        bool over = peak > budget;
+        printf("%-10s %8u %8u%s\n", mode_names[i], (unsigned)budget, (unsigned)peak, over ? "  超出预算!" : "");
+        if (over) ok = false;
+    }
+    if (mode_arena_failures()) printf("分配失败: %u 次\n", (unsigned)mode_arena_failures());
+    return ok;
+}
+
+static void print_state(void) {
+    int main_index = (int)appState.main_mode;
+    int item = main_index < MAIN_MODE_COUNT ? appState.item[main_index] : 0;
+    printf("[%8.3f s] main=%-9s item=%d mode=%d overlay=%d sub=%d running=%d\n",
+           sim_time_us() / 1e6, main_mode_names[main_index], item, (int)mode_current(),
+           (int)appState.overlay_mode, appState.in_sub_menu, appState.is_game_running);
+}
+
+int main(int argc, char** argv) {
+    bool verbose = false;
+    bool fixed_seed = false;
+    uint32_t seed = 0;
+    int tours = 1;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-v") == 0) verbose = true;
+        else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) { fixed_seed = true; seed = strtoul(argv[++i], NULL, 0); }
+        else tours = atoi(argv[i]);
+    }
+    if (tours < 1) tours = 1;
+
+    // 外部环境：按键松开、未充电、电池 3.9V (ADC 引脚上为分压后的一半)
+    sim_set_pin(LEFT_KEY_PIN, HIGH);
+    sim_set_pin(RIGHT_KEY_PIN, HIGH);
+    sim_set_pin(CHRG_PIN, HIGH);
+    sim_set_adc_millivolts(ADC_PIN, 3900 / 2);
+
+    clock_t wall_start = clock();
+    setup();
+    if (fixed_seed) rng_seed(seed);
+    printf("随机种子: 0x%08X\n", rng_get_seed());
+    for (int t = 0; t < tours; t++) {
+        for (const SimStep& step : tour) {
+            run_for(step.wait_ms);
+            perform(step.action);
+            if (verbose) print_state();
+        }
+    }
+    double wall_s = (double)(clock() - wall_start) / CLOCKS_PER_SEC;
+
+    print_report(wall_s);
+    bool arena_ok = check_mode_arena();
+
+#if ENABLE_PROFILER
+    // 通过串口命令触发统计输出，与真机上的用法一致
+    printf("\n==== 分阶段耗时统计 (us) ====\n");
+    sim_serial_inject("p");
+    loop();
+#endif
+    return arena_ok ? 0 : 1;
+}
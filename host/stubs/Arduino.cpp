@@ -0,0 +1,238 @@
+/**
+ * @file Arduino.cpp
+ * @author 多嘴龙虾
+ * @brief 主机模拟环境下的 Arduino 核心替身实现
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ */
+
+#include <Arduino.h>
+#include <EEPROM.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <time.h>
+
+/**
+ * @brief 主机CPU时间换算到目标MCU的倍数 (主机远快于 48MHz 的 Cortex-M0+)。
+ */
+#ifndef SIM_CPU_SCALE
+#define SIM_CPU_SCALE 1
+#endif
+
+HardwareSerial Serial;
+EEPROMClass EEPROM;
+
+// ------------------- 模拟时钟 -------------------
+static uint64_t sim_now_us = 0;
+
+static void apply_pin_events(void);
+
+uint64_t sim_time_us() { return sim_now_us; }
+void sim_advance_us(uint64_t us) { sim_now_us += us; apply_pin_events(); }
+
+uint32_t sim_cpu_clock_us() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    uint64_t host_ns = (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+    return (uint32_t)(sim_now_us + host_ns * SIM_CPU_SCALE / 1000);
+}
+
+// 与 MCU 一致，millis()/micros() 为 32 位计数，会回绕
+unsigned long millis() { return (uint32_t)(sim_now_us / 1000); }
+unsigned long micros() { return (uint32_t)sim_now_us; }
+void delay(unsigned long ms) { sim_advance_us((uint64_t)ms * 1000); }
+void delayMicroseconds(unsigned int us) { sim_advance_us(us); }
+// yield() 常出现在忙等循环中，每次推进少量时间防止模拟卡死
+void yield() { sim_advance_us(10); }
+
+// ------------------- GPIO / ADC -------------------
+static int pin_level[SIM_PIN_COUNT];
+static uint32_t adc_mv[SIM_PIN_COUNT];
+
+// 引脚中断
+static void (*pin_isr[SIM_PIN_COUNT])(void);
+static uint32_t pin_isr_mode[SIM_PIN_COUNT];
+static bool irq_enabled = true;
+static uint32_t irq_pending = 0; // 中断被屏蔽期间发生的边沿 (每个引脚一位)
+
+static void fire_pin_isr(uint32_t pin) {
+    if (!pin_isr[pin]) return;
+    if (irq_enabled) pin_isr[pin]();
+    else irq_pending |= 1u << pin;
+}
+
+static void set_level(uint32_t pin, int level) {
+    if (pin >= SIM_PIN_COUNT || pin_level[pin] == level) return;
+    pin_level[pin] = level;
+    uint32_t mode = pin_isr_mode[pin];
+    if (mode == CHANGE || (mode == RISING && level == HIGH) || (mode == FALLING && level == LOW)) {
+        fire_pin_isr(pin);
+    }
+}
+
+void attachInterrupt(uint32_t pin, void (*isr)(void), uint32_t mode) {
+    if (pin < SIM_PIN_COUNT) { pin_isr[pin] = isr; pin_isr_mode[pin] = mode; }
+}
+void detachInterrupt(uint32_t pin) { if (pin < SIM_PIN_COUNT) pin_isr[pin] = NULL; }
+void noInterrupts() { irq_enabled = false; }
+void interrupts() {
+    irq_enabled = true;
+    for (uint32_t pin = 0; irq_pending; pin++) {
+        if (irq_pending & (1u << pin)) { irq_pending &= ~(1u << pin); fire_pin_isr(pin); }
+    }
+}
+
+void pinMode(uint32_t pin, uint32_t mode) {
+    if (pin < SIM_PIN_COUNT && mode == INPUT_PULLUP) pin_level[pin] = HIGH;
+}
+int digitalRead(uint32_t pin) { return pin < SIM_PIN_COUNT ? pin_level[pin] : LOW; }
+void digitalWrite(uint32_t pin, uint32_t value) { set_level(pin, value ? HIGH : LOW); }
+void sim_set_pin(uint32_t pin, int level) { set_level(pin, level ? HIGH : LOW); }
+
+// 预约的引脚电平变化
+struct PinEvent { uint64_t at_us; uint32_t pin; int level; };
+static PinEvent pin_events[16];
+static int pin_event_count = 0;
+
+void sim_set_pin_at(uint32_t pin, int level, uint64_t at_us) {
+    if (pin_event_count < 16) pin_events[pin_event_count++] = {at_us, pin, level};
+    apply_pin_events();
+}
+
+static void apply_pin_events() {
+    for (int i = 0; i < pin_event_count; ) {
+        if (pin_events[i].at_us <= sim_now_us) {
+            sim_set_pin(pin_events[i].pin, pin_events[i].level);
+            pin_events[i] = pin_events[--pin_event_count];
+        } else {
+            i++;
+        }
+    }
+}
+
+// ------------------- 低功耗 -------------------
+const uint64_t SIM_STOP_SLICE_US = 10000;
+static bool sim_tick_running = true;
+
+// 最早一个预约的引脚电平变化时刻，没有时返回 UINT64_MAX
+static uint64_t next_pin_event_us() {
+    uint64_t next = UINT64_MAX;
+    for (int i = 0; i < pin_event_count; i++) {
+        if (pin_events[i].at_us < next) next = pin_events[i].at_us;
+    }
+    return next;
+}
+
+// 休眠到 limit_us，或更早的引脚电平变化 (中断) 时刻
+static void sim_sleep_until(uint64_t limit_us) {
+    uint64_t wake = next_pin_event_us();
+    if (wake > limit_us) wake = limit_us;
+    sim_advance_us(wake > sim_now_us ? wake - sim_now_us : 0);
+}
+
+void __WFI() {
+    uint64_t next_tick = sim_tick_running ? (sim_now_us / 1000 + 1) * 1000 : UINT64_MAX;
+    sim_sleep_until(next_tick);
+}
+
+void HAL_SuspendTick() { sim_tick_running = false; }
+void HAL_ResumeTick() { sim_tick_running = true; }
+void HAL_PWR_EnterSTOPMode(uint32_t, uint8_t) { sim_sleep_until(sim_now_us + SIM_STOP_SLICE_US); }
+// 真机的时钟配置用 HAL_GetTick() 等待振荡器就绪：SysTick 未恢复或中断被屏蔽时会一直等下去
+extern "C" void SystemClock_Config() {
+    if (!sim_tick_running || !irq_enabled) {
+        fprintf(stderr, "SystemClock_Config: SysTick 未恢复或中断被屏蔽，超时等待无法结束\n");
+        abort();
+    }
+}
+
+static int adc_bits = 10;
+void analogReadResolution(int bits) { adc_bits = bits; }
+void sim_set_adc_millivolts(uint32_t pin, uint32_t mv) { if (pin < SIM_PIN_COUNT) adc_mv[pin] = mv; }
+
+int analogRead(uint32_t pin) {
+    if (pin >= SIM_PIN_COUNT) return 0;
+    long full = (1L << adc_bits) - 1;
+    // 加入 ±2 LSB 的噪声，模拟真实 ADC
+    long raw = (long)adc_mv[pin] * full / 3300 + random(-2, 3);
+    return (int)constrain(raw, 0L, full);
+}
+
+uint32_t analogReadMillivolts(uint32_t pin) {
+    return pin < SIM_PIN_COUNT ? adc_mv[pin] : 0;
+}
+
+// ------------------- 数学与随机数 -------------------
+long map(long x, long in_min, long in_max, long out_min, long out_max) {
+    return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+// 独立于 libc 的线性同余发生器，保证各平台结果一致、可复现
+static uint32_t sim_rand_state = 1;
+
+static uint32_t sim_rand() {
+    sim_rand_state = sim_rand_state * 1103515245u + 12345u;
+    return sim_rand_state >> 1;
+}
+
+long random(long howbig) {
+    if (howbig <= 0) return 0;
+    return (long)(sim_rand() % (uint32_t)howbig);
+}
+
+long random(long howsmall, long howbig) {
+    if (howsmall >= howbig) return howsmall;
+    return random(howbig - howsmall) + howsmall;
+}
+
+void randomSeed(unsigned long seed) {
+    if (seed != 0) sim_rand_state = (uint32_t)seed;
+}
+
+// ------------------- 串口 -------------------
+static char serial_rx[256];
+static size_t serial_rx_head = 0, serial_rx_tail = 0;
+
+void sim_serial_inject(const char* s) {
+    while (*s && serial_rx_tail < sizeof(serial_rx)) serial_rx[serial_rx_tail++] = *s++;
+}
+
+void HardwareSerial::begin(unsigned long) {}
+int HardwareSerial::available() { return (int)(serial_rx_tail - serial_rx_head); }
+int HardwareSerial::read() {
+    if (serial_rx_head >= serial_rx_tail) return -1;
+    int c = (uint8_t)serial_rx[serial_rx_head++];
+    if (serial_rx_head == serial_rx_tail) serial_rx_head = serial_rx_tail = 0;
+    return c;
+}
+size_t HardwareSerial::print(const char* s) { return fputs(s, stdout) >= 0 ? strlen(s) : 0; }
+size_t HardwareSerial::print(char c) { return fputc(c, stdout) != EOF; }
+size_t HardwareSerial::print(long n) { return ::printf("%ld", n); }
+size_t HardwareSerial::print(unsigned long n) { return ::printf("%lu", n); }
+size_t HardwareSerial::println() { return print("\n"); }
+size_t HardwareSerial::println(const char* s) { return print(s) + println(); }
+size_t HardwareSerial::println(long n) { return print(n) + println(); }
+size_t HardwareSerial::println(unsigned long n) { return print(n) + println(); }
+size_t HardwareSerial::printf(const char* fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vprintf(fmt, ap);
+    va_end(ap);
+    return n > 0 ? (size_t)n : 0;
+}
+
+// ------------------- EEPROM -------------------
+static uint8_t eeprom_data[1024];
+static bool eeprom_ready = false;
+
+uint8_t EEPROMClass::read(int addr) {
+    if (!eeprom_ready) { memset(eeprom_data, 0xFF, sizeof(eeprom_data)); eeprom_ready = true; }
+    return (addr >= 0 && addr < (int)sizeof(eeprom_data)) ? eeprom_data[addr] : 0xFF;
+}
+
+void EEPROMClass::write(int addr, uint8_t value) {
+    read(0);
+    if (addr >= 0 && addr < (int)sizeof(eeprom_data)) { eeprom_data[addr] = value; writes++; }
+}
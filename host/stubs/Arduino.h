@@ -0,0 +1,163 @@
+/**
+ * @file Arduino.h
+ * @author 多嘴龙虾
+ * @brief 主机模拟环境下的 Arduino 核心替身
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * 只提供固件实际用到的 Arduino API：模拟时钟 (millis/micros/delay)、
+ * GPIO、引脚中断、低功耗 (WFI/STOP)、ADC、随机数和串口。时间完全由模拟时钟驱动，delay() 只推进时钟
+ * 而不真正睡眠，因此固件可以远快于实时运行。
+ */
+
+#ifndef _HOST_ARDUINO_H_
+#define _HOST_ARDUINO_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "pgmspace.h"
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+// ------------------- 引脚定义 (与 Air001 保持一致的名称) -------------------
+enum {
+    PA0, PA1, PA2, PA3, PA4, PA5, PA6, PA7,
+    PA8, PA9, PA10, PA11, PA12, PA13, PA14, PA15,
+    SIM_PIN_COUNT
+};
+
+#define LOW          0
+#define HIGH         1
+#define INPUT        0
+#define OUTPUT       1
+#define INPUT_PULLUP 2
+
+// 引脚中断触发方式
+#define CHANGE       2
+#define FALLING      3
+#define RISING       4
+
+#define digitalPinToInterrupt(pin) (pin)
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+// ------------------- 时间 -------------------
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield(void);
+
+// ------------------- GPIO / ADC -------------------
+void pinMode(uint32_t pin, uint32_t mode);
+int digitalRead(uint32_t pin);
+void digitalWrite(uint32_t pin, uint32_t value);
+int analogRead(uint32_t pin);
+uint32_t analogReadMillivolts(uint32_t pin);
+void analogReadResolution(int bits);
+
+/**
+ * @brief 注册引脚中断。模拟器在引脚电平按触发方式变化时立即调用 isr。
+ */
+void attachInterrupt(uint32_t pin, void (*isr)(void), uint32_t mode);
+void detachInterrupt(uint32_t pin);
+void noInterrupts(void);
+void interrupts(void);
+
+// ------------------- 低功耗 (CMSIS / HAL 替身) -------------------
+#define PWR_LOWPOWERREGULATOR_ON 1
+#define PWR_STOPENTRY_WFI        1
+
+/**
+ * @brief 休眠到下一个 SysTick (1ms 边界) 或更早的引脚中断。
+ */
+void __WFI(void);
+void HAL_SuspendTick(void);
+void HAL_ResumeTick(void);
+
+/**
+ * @brief STOP 模式：SysTick 停止时休眠到下一次引脚中断。
+ * @note 模拟器中每次最多休眠 SIM_STOP_SLICE_US 后返回 (相当于一次无关的唤醒)，
+ *       使按键脚本在固件睡眠期间仍能推进；固件应在没有唤醒源时继续睡眠。
+ */
+void HAL_PWR_EnterSTOPMode(uint32_t regulator, uint8_t entry);
+extern "C" void SystemClock_Config(void);
+
+// ------------------- 数学与随机数 -------------------
+long map(long x, long in_min, long in_max, long out_min, long out_max);
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+
+// ------------------- 串口 -------------------
+class HardwareSerial {
+public:
+    void begin(unsigned long baud);
+    int available(void);
+    int read(void);
+    size_t print(const char* s);
+    size_t print(char c);
+    size_t print(long n);
+    size_t print(unsigned long n);
+    size_t print(int n) { return print((long)n); }
+    size_t print(unsigned int n) { return print((unsigned long)n); }
+    size_t println(void);
+    size_t println(const char* s);
+    size_t println(long n);
+    size_t println(unsigned long n);
+    size_t println(int n) { return println((long)n); }
+    size_t println(unsigned int n) { return println((unsigned long)n); }
+    size_t printf(const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+};
+extern HardwareSerial Serial;
+
+/******************************************************************************
+ *                        模拟器控制接口 (仅主机可用)
+ ******************************************************************************/
+
+/**
+ * @brief 获取当前模拟时间 (单位: 微秒，不回绕)。
+ */
+uint64_t sim_time_us(void);
+
+/**
+ * @brief 性能统计用时钟 (单位: 微秒)：模拟时间 + 主机上实际消耗的CPU时间。
+ * @details 模拟时钟只在 delay()/发送时前进，纯计算阶段在模拟时间上耗时为0；
+ *          叠加主机CPU时间 (乘以 SIM_CPU_SCALE) 后，计算密集的阶段才能被区分出来。
+ */
+uint32_t sim_cpu_clock_us(void);
+
+/**
+ * @brief 推进模拟时钟。
+ */
+void sim_advance_us(uint64_t us);
+
+/**
+ * @brief 设置引脚的输入电平 (模拟按键、充电指示等外部信号)。
+ * @details 电平变化时触发该引脚上注册的中断 (中断被屏蔽时延后到 interrupts() 再触发)。
+ */
+void sim_set_pin(uint32_t pin, int level);
+
+/**
+ * @brief 预约在指定的模拟时刻改变引脚电平。
+ * @details 电平在固件运行途中 (模拟时钟经过该时刻时) 改变，与真实按键一样
+ *          可能发生在 loop() 的任意位置，而不是只在两次 loop() 之间。
+ */
+void sim_set_pin_at(uint32_t pin, int level, uint64_t at_us);
+
+/**
+ * @brief 设置 ADC 引脚上的模拟电压 (单位: 毫伏)。
+ */
+void sim_set_adc_millivolts(uint32_t pin, uint32_t mv);
+
+/**
+ * @brief 向串口接收缓冲写入数据，模拟上位机发送的命令。
+ */
+void sim_serial_inject(const char* s);
+
+#endif
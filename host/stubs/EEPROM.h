@@ -0,0 +1,26 @@
+/**
+ * @file EEPROM.h
+ * @author 多嘴龙虾
+ * @brief 主机模拟环境下的 EEPROM 替身 (内存数组，初始值为 0xFF)。
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ */
+
+#ifndef _HOST_EEPROM_H_
+#define _HOST_EEPROM_H_
+
+#include <stdint.h>
+
+class EEPROMClass {
+public:
+    void begin(void) {}
+    uint8_t read(int addr);
+    void write(int addr, uint8_t value);
+    uint32_t write_count(void) const { return writes; }
+private:
+    uint32_t writes = 0;
+};
+extern EEPROMClass EEPROM;
+
+#endif
@@ -0,0 +1,104 @@
+/**
+ * @file WS2812_SYC_Air001.cpp
+ * @author 多嘴龙虾
+ * @brief 主机模拟环境下的 SYC_WS2812 驱动替身实现
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ */
+
+#include "WS2812_SYC_Air001.h"
+
+// 调色板索引 -> GRB 颜色
+static const uint32_t palette[] = {
+    BLACK_Color, RED_Color, GREEN_Color, BLUE_Color,
+    WHITE_Color, YELLOW_Color, ORANGE_Color, PINK_Color
+};
+
+SYC_WS2812::SYC_WS2812(uint16_t number, uint8_t brightness)
+    : sim_show_count(0), sim_pixels_sent(0), sim_tx_us(0),
+      number(number > 64 ? 64 : number), brightness(brightness) {
+    memset(led_data, 0, sizeof(led_data));
+    memset(sim_shown, 0, sizeof(sim_shown));
+}
+
+void SYC_WS2812::setup() {
+    clearWs2812();
+}
+
+void SYC_WS2812::clearWs2812() {
+    memset(led_data, 0, sizeof(led_data));
+}
+
+void SYC_WS2812::setWs2812Color(int index, uint32_t color) {
+    if (index < 0 || index >= number) return;
+    led_data[index] = color;
+}
+
+void SYC_WS2812::setBrightness(uint8_t value) {
+    brightness = value;
+}
+
+void SYC_WS2812::Ws2812_show() {
+    Ws2812_show(number);
+}
+
+void SYC_WS2812::Ws2812_show(uint16_t count) {
+    if (count > number) count = number;
+    for (int i = 0; i < count; i++) {
+        uint32_t c = led_data[i];
+        uint32_t g = ((c >> 16) & 0xFF) * brightness / 255;
+        uint32_t r = ((c >> 8) & 0xFF) * brightness / 255;
+        uint32_t b = (c & 0xFF) * brightness / 255;
+        sim_shown[i] = (g << 16) | (r << 8) | b;
+    }
+    // 比特流发送期间关中断，CPU 被完全占用
+    uint32_t tx = count * SIM_WS2812_US_PER_PIXEL + SIM_WS2812_RESET_US;
+    sim_show_count++;
+    sim_pixels_sent += count;
+    sim_tx_us += tx;
+    sim_advance_us(tx);
+}
+
+uint32_t SYC_WS2812::Wheel(uint8_t pos) {
+    uint8_t r, g, b;
+    pos = 255 - pos;
+    if (pos < 85) {
+        r = 255 - pos * 3; g = 0; b = pos * 3;
+    } else if (pos < 170) {
+        pos -= 85;
+        r = 0; g = pos * 3; b = 255 - pos * 3;
+    } else {
+        pos -= 170;
+        r = pos * 3; g = 255 - pos * 3; b = 0;
+    }
+    return ((uint32_t)g << 16) | ((uint32_t)r << 8) | b;
+}
+
+// 位图格式：两个 32 位字，像素 i 对应 num[i / 32] 的第 (31 - i % 32) 位
+static bool bitmap_bit(const uint32_t* num, int i) {
+    return (pgm_read_dword(&num[i >> 5]) >> (31 - (i & 31))) & 1;
+}
+
+void SYC_WS2812::Draw(const uint32_t* num, const uint8_t* color) {
+    int k = 0;
+    for (int i = 0; i < number; i++) {
+        if (bitmap_bit(num, i)) {
+            uint8_t idx = pgm_read_byte(&color[k++]);
+            led_data[i] = palette[idx < sizeof(palette) / sizeof(palette[0]) ? idx : 0];
+        }
+    }
+}
+
+void SYC_WS2812::Draw_pic(const uint32_t* num, const uint8_t* color) {
+    Draw(num, color);
+}
+
+void SYC_WS2812::Rainbow_bitmap(uint8_t speed, const uint32_t* num) {
+    uint8_t base = (millis() / (speed ? speed : 1)) & 0xFF;
+    for (int i = 0; i < number; i++) {
+        if (bitmap_bit(num, i)) {
+            led_data[i] = Wheel(base + i * 4);
+        }
+    }
+}
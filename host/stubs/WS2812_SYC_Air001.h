@@ -0,0 +1,80 @@
+/**
+ * @file WS2812_SYC_Air001.h
+ * @author 多嘴龙虾
+ * @brief 主机模拟环境下的 SYC_WS2812 驱动替身
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * 接口与固件使用的驱动库保持一致。颜色为 32 位 GRB 格式，led_data 保存
+ * 未经亮度缩放的原始颜色，亮度只在发送时生效。Ws2812_show() 会按照真实的
+ * 比特流时长 (每像素 24bit x 1.25us + 复位时间) 推进模拟时钟，用来评估
+ * 发送在一帧中所占的时间。
+ */
+
+#ifndef _HOST_WS2812_SYC_AIR001_H_
+#define _HOST_WS2812_SYC_AIR001_H_
+
+#include <Arduino.h>
+
+// --- 位图调色板索引 (Bitmap.cpp 中的颜色数组使用) ---
+enum : uint8_t {
+    BLACK,
+    RED,
+    GREEN,
+    BLUE,
+    WHITE,
+    YELLOW,
+    ORANGE,
+    PINK
+};
+
+// --- 常用 GRB 颜色 ---
+const uint32_t BLACK_Color  = 0x000000;
+const uint32_t RED_Color    = 0x00FF00;
+const uint32_t GREEN_Color  = 0xFF0000;
+const uint32_t BLUE_Color   = 0x0000FF;
+const uint32_t WHITE_Color  = 0xFFFFFF;
+const uint32_t YELLOW_Color = 0xFFFF00;
+const uint32_t ORANGE_Color = 0x80FF00;
+const uint32_t PINK_Color   = 0x40FF80;
+
+/**
+ * @brief 单个 WS2812 像素的发送时间 (单位: 微秒)。
+ */
+const uint32_t SIM_WS2812_US_PER_PIXEL = 30;
+/**
+ * @brief WS2812 复位 (锁存) 时间 (单位: 微秒)。
+ */
+const uint32_t SIM_WS2812_RESET_US = 50;
+
+class SYC_WS2812 {
+public:
+    SYC_WS2812(uint16_t number, uint8_t brightness);
+
+    void setup(void);
+    void clearWs2812(void);
+    void setWs2812Color(int index, uint32_t color);
+    void setBrightness(uint8_t brightness);
+    void Ws2812_show(void);
+    void Ws2812_show(uint16_t count);
+    uint32_t Wheel(uint8_t pos);
+
+    void Draw(const uint32_t* num, const uint8_t* color);
+    void Draw_pic(const uint32_t* num, const uint8_t* color);
+    void Rainbow_bitmap(uint8_t speed, const uint32_t* num);
+
+    uint32_t led_data[64];
+
+    // ---- 模拟器观测接口 ----
+    uint32_t sim_shown[64];     // 灯珠上实际显示的颜色 (已应用亮度)
+    uint32_t sim_show_count;    // Ws2812_show() 调用次数
+    uint32_t sim_pixels_sent;   // 累计发送的像素数
+    uint64_t sim_tx_us;         // 累计发送耗时
+
+private:
+    uint16_t number;
+    uint8_t brightness;
+};
+
+#endif
@@ -0,0 +1,24 @@
+/**
+ * @file pgmspace.h
+ * @author 多嘴龙虾
+ * @brief 主机模拟环境下的 PROGMEM 替身，数据直接放在普通内存中。
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ */
+
+#ifndef _HOST_PGMSPACE_H_
+#define _HOST_PGMSPACE_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+#define PSTR(s) (s)
+#define pgm_read_byte(addr)  (*(const uint8_t*)(addr))
+#define pgm_read_word(addr)  (*(const uint16_t*)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t*)(addr))
+#define pgm_read_ptr(addr)   (*(void* const*)(addr))
+#define memcpy_P memcpy
+
+#endif
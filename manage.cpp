@@ -5,17 +5,11 @@ static BatteryLevel battery_level_snapshot;
 const unsigned long CHARGING_ICON_INTERVAL = 300; 
 // 动画总共有5个图标，播放2遍，所以总共是 10 帧
 const unsigned long CHARGING_ANIM_DURATION = CHARGING_ICON_INTERVAL * 10;
-// 动画开始计时器
-static unsigned long charging_anim_start_time = 0;
 static uint8_t preview_brightness_level;
 
 AppState appState = {
     .main_mode = MainMode::ANIMATION,
-    .anim_mode = AnimMode::FLAME,
-    .pic_mode  = PicMode::CAT,
-    .game_mode = GameMode::PINBALL,
-    .letter_mode = LetterMode::Letter_A,
-    .number_mode = NumberMode::Number_0,
+    .item = {0},
     .tool_mode = ToolMode::SETTINGS,
     .overlay_mode = SystemOverlayMode::NONE,
     .in_sub_menu = false,
@@ -48,6 +42,57 @@ void save_brightness_to_eeprom(uint8_t level) {
     }
 }
 
+/**
+ * @brief 当前主菜单项选中的模式及其变体。
+ */
+static ModeId selected_mode(uint8_t& variant) {
+    return main_mode_item(appState.main_mode, appState.item[(int)appState.main_mode], variant);
+}
+
+/**
+ * @brief 选中当前主菜单项的第 item 项；对应的模式变化时进入新模式，只换变体时保留状态。
+ */
+static void select_item(uint8_t item) {
+    appState.item[(int)appState.main_mode] = item;
+    uint8_t variant;
+    ModeId id = selected_mode(variant);
+    if (id != mode_current()) mode_enter(id);
+}
+
+/**
+ * @brief 进入 (或重新开始) 当前选中的模式。
+ */
+static void enter_selected_mode() {
+    uint8_t variant;
+    mode_enter(selected_mode(variant));
+}
+
+/**
+ * @brief 菜单和循环模式中的“上一个/下一个”手势。
+ * @details 左键单击、长按和按住自动重复为下一项 (按住左键可加速滚动)，
+ *          按住右键时单击左键为上一项。
+ * @return +1 下一项，-1 上一项，0 不是导航手势。
+ */
+static int8_t nav_step(KeyEvent event) {
+    switch (event) {
+        case KeyEvent::LEFT_CLICK:
+        case KeyEvent::LEFT_LONG_PRESS:
+        case KeyEvent::LEFT_REPEAT:
+            return 1;
+        case KeyEvent::RIGHT_HOLD_LEFT_CLICK:
+            return -1;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief 在 count 项中循环移动 step 步。
+ */
+static uint8_t wrap_step(uint8_t index, int8_t step, uint8_t count) {
+    return (uint8_t)((index + count + step) % count);
+}
+
 //======================================================================
 //   核心：输入处理函数 (State Changer) - [重构后版本]
 //======================================================================
@@ -55,6 +100,9 @@ void handle_input() {
     KeyEvent event = read_key_event();
     if (event == KeyEvent::NO_EVENT) return;
 
+    // --- 优先级 0: 用于唤醒 (或打断熄屏淡出) 的按键不触发任何操作 ---
+    if (power_filter_key(event)) return;
+
     // --- 优先级 1: 如果正在显示电量，则忽略所有按键输入 ---
     if (appState.overlay_mode == SystemOverlayMode::BATTERY_DISPLAY) {
         return; 
@@ -71,90 +119,54 @@ void handle_input() {
         return; 
     }
 
-    // --- 优先级 3: 处理全屏运行状态 (动画/图片/游戏) ---
+    MainModeDesc main;
+    main_mode_get(appState.main_mode, main);
+    uint8_t item = appState.item[(int)appState.main_mode];
+
+    // --- 优先级 3: 处理全屏运行状态 (动画/图片/游戏/字母/数字) ---
+    int8_t step = nav_step(event);
     if (appState.is_game_running) {
-        // ---- 动画模式下的特殊处理 ----
-        if (appState.main_mode == MainMode::ANIMATION) {
-            if (event == KeyEvent::LEFT_CLICK) {
-                // 左键单击，切换到下一个动画
-                appState.anim_mode = static_cast<AnimMode>(((int)appState.anim_mode + 1) % 4);
-            }
-            // 右键单击（确认键）在此处无效，直接忽略。
-        }
-        if (appState.main_mode == MainMode::PIC) {
-            if (event == KeyEvent::LEFT_CLICK) {
-                // 左键单击，切换到下一个动画
-                appState.pic_mode = static_cast<PicMode>(((int)appState.pic_mode + 1) % 6);
-            }
-            // 右键单击（确认键）在此处无效，直接忽略。
-        } 
-        if (appState.main_mode == MainMode::LETTER) {
-            if (event == KeyEvent::LEFT_CLICK) {
-                // 左键单击，切换到下一个动画
-                appState.letter_mode = static_cast<LetterMode>(((int)appState.letter_mode + 1) % 26);
-            }
-            // 右键单击（确认键）在此处无效，直接忽略。
-        }
-        if (appState.main_mode == MainMode::NUMBER) {
-            if (event == KeyEvent::LEFT_CLICK) {
-                // 左键单击，切换到下一个动画
-                appState.number_mode = static_cast<NumberMode>(((int)appState.number_mode + 1) % 10);
-            }
-            // 右键单击（确认键）在此处无效，直接忽略。
-        }
-        // ---- 游戏模式下的处理 (保持或待实现) ----
-        else if (appState.main_mode == MainMode::GAME) {
-            // 这里可以把按键事件传递给具体游戏，用于控制
-            game_handle_input(event); 
+        if ((main.flags & MAIN_CYCLE) && step) {
+            // 切换到下一项 / 上一项
+            select_item(wrap_step(item, step, main.count));
+        } else {
+            // 其余按键交给当前模式 (例如火焰动画的右键切换调色板、游戏的操控)
+            ModeDesc desc;
+            mode_get(mode_current(), desc);
+            if (desc.input) desc.input(event);
         }
 
         // ---- 通用的退出逻辑 ----
         if (event == KeyEvent::RIGHT_LONG_PRESS) {
             appState.is_game_running = false;
             appState.in_sub_menu = false;
-            
-            // ★★★ 可选的强化：在退出游戏时，调用其初始化函数来重置内部状态 ★★★
-            if (appState.main_mode == MainMode::GAME) {
-                switch(appState.game_mode) {
-                    case GameMode::SNAKE:   snake_init();   break;
-                    case GameMode::PINBALL: pinball_init(); break;
-                    // 其他游戏...
-                }
-            }
-            if(appState.main_mode == MainMode::ANIMATION){
-                meteor_animation_initialized = false;
-            }
+            mode_leave(); // 释放模式状态，下次进入时重新初始化
         }
         return; // 拦截下面的UI导航逻辑
     }
 
     // --- 优先级 4: 处理常规的UI菜单导航 ---
-    switch (event) {
-        case KeyEvent::LEFT_CLICK: // “下一个”
-            if (appState.in_sub_menu) {
-                switch (appState.main_mode) {
-                    case MainMode::GAME:
-                        appState.game_mode = static_cast<GameMode>(((int)appState.game_mode + 1) % 3);
-                        break;
-                    case MainMode::TOOL:
-                        // ★★★ 修改：现在操作的是“预览”变量 ★★★
-                        preview_brightness_level = (preview_brightness_level + 1) % 5;
-                        break;
-                }
+    if (step) { // “下一个 / 上一个”
+        if (appState.in_sub_menu) {
+            if (appState.main_mode == MainMode::TOOL) {
+                // ★★★ 修改：现在操作的是“预览”变量 ★★★
+                preview_brightness_level = wrap_step(preview_brightness_level, step, 5);
             } else {
-                appState.main_mode = static_cast<MainMode>(((int)appState.main_mode + 1) % 6);
+                select_item(wrap_step(item, step, main.count)); // 子菜单中预览下一项 / 上一项
             }
-            break;
+        } else {
+            appState.main_mode = static_cast<MainMode>(wrap_step((uint8_t)appState.main_mode, step, MAIN_MODE_COUNT));
+        }
+        return;
+    }
 
+    switch (event) {
         case KeyEvent::RIGHT_CLICK: // “进入 / 确认”
-            if (appState.main_mode == MainMode::ANIMATION || appState.main_mode == MainMode::PIC || appState.main_mode == MainMode::LETTER || appState.main_mode == MainMode::NUMBER) {
+            if (!(main.flags & MAIN_SUB_MENU)) {
                 appState.is_game_running = true;
+                enter_selected_mode();
             } else {
                 if (appState.in_sub_menu) {
-                    if (appState.main_mode == MainMode::GAME) {
-                        appState.is_game_running = true;
-                        game_start(appState.game_mode); 
-                    }
                     // ★★★ 在 Tool 子菜单中，右键单击现在是“确认并退出” ★★★
                     if (appState.main_mode == MainMode::TOOL) {
                         // 1. 将最终确定的亮度值赋给全局状态
@@ -163,6 +175,10 @@ void handle_input() {
                         save_brightness_to_eeprom(appState.brightness_level);
                         // 3. 退出子菜单
                         appState.in_sub_menu = false;
+                    } else {
+                        // 从预览正式开始，重新初始化
+                        appState.is_game_running = true;
+                        enter_selected_mode();
                     }
                 } else { // 如果在主菜单里
                     // ★★★ 进入 Tool 子菜单前的准备工作 ★★★
@@ -171,6 +187,7 @@ void handle_input() {
                         preview_brightness_level = appState.brightness_level;
                     }
                     appState.in_sub_menu = true;
+                    enter_selected_mode(); // 子菜单中的预览图标使用模式状态
                 }
             }
             break;
@@ -178,15 +195,54 @@ void handle_input() {
         case KeyEvent::RIGHT_LONG_PRESS: // “返回 / 退出”
             if (appState.in_sub_menu) {
                 appState.in_sub_menu = false;
+                mode_leave();
             }
             break;
+
+        default:
+            break;
     }
 }
 
+//======================================================================
+//   帧率配置：每个模式在注册表中声明自己的目标帧率 (fps)
+//======================================================================
+const uint8_t FPS_OVERLAY       = 20; // 电量/充电覆盖层，画面基本静止
+const uint8_t FPS_MENU          = 30; // 菜单图标
+
+/**
+ * @brief 根据当前状态返回目标帧率。
+ */
+uint8_t get_target_fps() {
+    if (appState.overlay_mode != SystemOverlayMode::NONE) return FPS_OVERLAY;
+    if (!appState.is_game_running || mode_current() == ModeId::NONE) return FPS_MENU;
+
+    ModeDesc desc;
+    mode_get(mode_current(), desc);
+    return desc.fps;
+}
+
+#if ENABLE_PROFILER
+/**
+ * @brief 将当前状态映射为性能统计的模式分类。
+ */
+ProfileMode profile_mode_of_state() {
+    if (appState.overlay_mode != SystemOverlayMode::NONE) return PROF_MODE_OVERLAY;
+    if (!appState.is_game_running || mode_current() == ModeId::NONE) return PROF_MODE_MENU;
+    // ProfileMode 中各模式的分类与 ModeId 顺序一致
+    return static_cast<ProfileMode>(PROF_MODE_FLAME + (int)mode_current());
+}
+#endif
+
+// 上一帧的渲染者是哪个保留画面的模式 (NONE 表示每帧清屏)
+static ModeId last_retained_mode = ModeId::NONE;
+
 //======================================================================
 //   核心：渲染函数 (State Renderer) - [已修复全局亮度问题]
+//   sim_steps: 调度器给出的本帧模拟步数，按帧推进的动画(火焰、流星)
+//              据此追帧，保证速度与CPU负载无关
 //======================================================================
-void render_frame() {
+void render_frame(uint8_t sim_steps) {
     // --- 步骤 0: 检查后台"充电状态变化"信号 ---
     if (g_charging_started_event) {
         ChargingState charging_state = getCurrentChargingState();
@@ -230,7 +286,22 @@ void render_frame() {
             break;
     }
     
-    strip.clearWs2812(); // 每帧开始前先清空屏幕
+    // 每帧开始前先清空屏幕；保留画面的模式只在刚切换进来时清一次
+    bool running = appState.overlay_mode == SystemOverlayMode::NONE && appState.is_game_running
+                   && mode_current() != ModeId::NONE;
+    ModeDesc desc;
+    if (running) mode_get(mode_current(), desc);
+    ModeId retained = (running && (desc.flags & MODE_RETAINED)) ? mode_current() : ModeId::NONE;
+    // 刚从睡眠中唤醒：熄屏时画面已清空，保留画面的模式同样需要整体重绘
+    if (power_woke()) last_retained_mode = ModeId::NONE;
+    if (retained == ModeId::NONE || retained != last_retained_mode) {
+        strip.clearWs2812();
+        // 画面已清空，通知保留画面的模式下一次整体重绘
+        if (retained != ModeId::NONE && desc.invalidate) desc.invalidate();
+    }
+    last_retained_mode = retained;
+
+    PROFILE_BEGIN(render_t0);
 
     // --- 步骤1: 优先渲染系统覆盖层 ---
     if (appState.overlay_mode != SystemOverlayMode::NONE) {
@@ -248,88 +319,28 @@ void render_frame() {
     }
     // --- 步骤2: 渲染主内容（UI菜单 或 全屏动画/游戏）---
     else { // ★★★ 使用 else 结构，保证覆盖层和主内容只渲染一个 ★★★
-        if (appState.is_game_running) {
-            // ---- A. 渲染全屏动画/游戏 ----
-            switch (appState.main_mode) {
-                case MainMode::ANIMATION:
-                    switch(appState.anim_mode) {
-                        case AnimMode::FLAME:   flameEffect_lowRam(strip, 30, 200, false); break;
-                        case AnimMode::RAINBOW: anim_rainbow_flow(strip, 20, 2); break;
-                        case AnimMode::RAINBOW_HEART:  anim_beating_heart(strip, 250); break;
-                        case AnimMode::METEOR:  anim_meteor_shower(strip, 12); break;
-                    }
-                    break;
-                case MainMode::PIC:
-                    switch(appState.pic_mode) {
-                        case PicMode::CAT:   strip.Draw_pic(Cat, Cat_color); break;
-                        case PicMode::PEACH: strip.Draw_pic(Peach, Peach_color); break;
-                        case PicMode::HEART: strip.Draw_pic(Heart, Heart_color); break;
-                        case PicMode::DARK:  strip.Draw_pic(Dark, Dark_color); break;
-                        case PicMode::SWORD: strip.Draw_pic(Sword, Sword_color); break;
-                        case PicMode::DOG:   strip.Draw_pic(Dog, Dog_color); break;
-                    }
-                    break;
-                case MainMode::GAME:
-                    game_update_and_render(strip);
-                    break;
-                case MainMode::LETTER:
-                    switch(appState.letter_mode) {
-                        case LetterMode::Letter_A: strip.Rainbow_bitmap(20, letter_a_num); break;
-                        case LetterMode::Letter_B: strip.Rainbow_bitmap(20, letter_b_num); break;
-                        case LetterMode::Letter_C: strip.Rainbow_bitmap(20, letter_c_num); break;
-                        case LetterMode::Letter_D: strip.Rainbow_bitmap(20, letter_d_num); break;
-                        case LetterMode::Letter_E: strip.Rainbow_bitmap(20, letter_e_num); break;
-                        case LetterMode::Letter_F: strip.Rainbow_bitmap(20, letter_f_num); break;
-                        case LetterMode::Letter_G: strip.Rainbow_bitmap(20, letter_g_num); break;
-                        case LetterMode::Letter_H: strip.Rainbow_bitmap(20, letter_h_num); break;
-                        case LetterMode::Letter_I: strip.Rainbow_bitmap(20, letter_i_num); break;
-                        case LetterMode::Letter_J: strip.Rainbow_bitmap(20, letter_j_num); break;
-                        case LetterMode::Letter_K: strip.Rainbow_bitmap(20, letter_k_num); break;
-                        case LetterMode::Letter_L: strip.Rainbow_bitmap(20, letter_l_num); break;
-                        case LetterMode::Letter_M: strip.Rainbow_bitmap(20, letter_m_num); break;
-                        case LetterMode::Letter_N: strip.Rainbow_bitmap(20, letter_n_num); break;
-                        case LetterMode::Letter_O: strip.Rainbow_bitmap(20, letter_o_num); break;
-                        case LetterMode::Letter_P: strip.Rainbow_bitmap(20, letter_p_num); break;
-                        case LetterMode::Letter_Q: strip.Rainbow_bitmap(20, letter_q_num); break;
-                        case LetterMode::Letter_R: strip.Rainbow_bitmap(20, letter_r_num); break;
-                        case LetterMode::Letter_S: strip.Rainbow_bitmap(20, letter_s_num); break;
-                        case LetterMode::Letter_T: strip.Rainbow_bitmap(20, letter_t_num); break;
-                        case LetterMode::Letter_U: strip.Rainbow_bitmap(20, letter_u_num); break;
-                        case LetterMode::Letter_V: strip.Rainbow_bitmap(20, letter_v_num); break;
-                        case LetterMode::Letter_W: strip.Rainbow_bitmap(20, letter_w_num); break;
-                        case LetterMode::Letter_X: strip.Rainbow_bitmap(20, letter_x_num); break;
-                        case LetterMode::Letter_Y: strip.Rainbow_bitmap(20, letter_y_num); break;
-                        case LetterMode::Letter_Z: strip.Rainbow_bitmap(20, letter_z_num); break;
-                    }
-                    break;
-                case MainMode::NUMBER:
-                    switch(appState.number_mode) {
-                        case NumberMode::Number_0: strip.Rainbow_bitmap(20, number_0_num); break;
-                        case NumberMode::Number_1: strip.Rainbow_bitmap(20, number_1_num); break;
-                        case NumberMode::Number_2: strip.Rainbow_bitmap(20, number_2_num); break;
-                        case NumberMode::Number_3: strip.Rainbow_bitmap(20, number_3_num); break;
-                        case NumberMode::Number_4: strip.Rainbow_bitmap(20, number_4_num); break;
-                        case NumberMode::Number_5: strip.Rainbow_bitmap(20, number_5_num); break;
-                        case NumberMode::Number_6: strip.Rainbow_bitmap(20, number_6_num); break;
-                        case NumberMode::Number_7: strip.Rainbow_bitmap(20, number_7_num); break;
-                        case NumberMode::Number_8: strip.Rainbow_bitmap(20, number_8_num); break;
-                        case NumberMode::Number_9: strip.Rainbow_bitmap(20, number_9_num); break;
-                    }
-                    break;
-            }
+        if (running) {
+            // ---- A. 渲染全屏动画/游戏：按编号取出描述符，一次调用 ----
+            uint8_t variant;
+            selected_mode(variant);
+            desc.frame(strip, variant, sim_steps);
         }
         else {
             // ---- B. 渲染UI导航菜单 ----
             if (appState.in_sub_menu) {
-                switch (appState.main_mode) {
-                    case MainMode::GAME: draw_game_icon(appState.game_mode); break;
-                    case MainMode::TOOL: draw_tool_icon(appState.tool_mode); break;
+                if (appState.main_mode == MainMode::TOOL) {
+                    draw_tool_icon(appState.tool_mode);
+                } else if (mode_current() != ModeId::NONE) {
+                    ModeDesc sub;
+                    mode_get(mode_current(), sub);
+                    if (sub.icon) sub.icon(strip);
                 }
             } else {
                 draw_main_menu_icon(appState.main_mode);
             }
         }
     }
+    PROFILE_END(render_t0, PROF_STAGE_RENDER);
 
     uint8_t real_brightness;
     // ★★★ 核心修改：判断当前是否在设置界面 ★★★
@@ -345,8 +356,11 @@ void render_frame() {
         case 4: real_brightness = 255; break;
         default: real_brightness = 90;
     }
-    strip.setBrightness(real_brightness);
-    strip.Ws2812_show();
+    // 画面未变化时跳过发送，统计按覆盖层/主模式分类
+    MainMode stats_mode = (appState.overlay_mode != SystemOverlayMode::NONE)
+                          ? MainMode::SYSTEM_OVERLAY
+                          : appState.main_mode;
+    Ws2812_present(power_scale_brightness(real_brightness), stats_mode); // 熄屏前逐渐淡出
 }
 
 void render_battery_display() {
@@ -386,28 +400,9 @@ void render_battery_display() {
 // 这些函数现在不操作 strip 对象，只打印信息到串口
 
 void draw_main_menu_icon(MainMode mode) {
-    switch(mode) {
-        case MainMode::ANIMATION: anim_logo(strip, 250); break;
-        case MainMode::PIC:       strip.Draw_pic(pic_icon_num, pic_icon_color);   break;
-        case MainMode::GAME:      strip.Draw_pic(snake_icon_num, snake_icon_color);  break;
-        case MainMode::LETTER:    strip.Rainbow_bitmap(20, letter_icon_num);break;
-        case MainMode::NUMBER:    strip.Rainbow_bitmap(20, number_icon_num);break;
-        case MainMode::TOOL:      strip.Rainbow_bitmap(20, tool_icon_num);  break;
-    }
-}
-
-void draw_game_icon(GameMode mode) {
-    switch(mode) {
-        case GameMode::PINBALL:      
-            draw_pinball_icon(strip); 
-            break;
-        case GameMode::SNAKE:        
-            draw_snake_icon(strip);
-            break;
-        case GameMode::GAME_OF_LIFE: 
-            draw_gol_icon(strip, 250);
-            break;
-    }
+    MainModeDesc main;
+    main_mode_get(mode, main);
+    main.icon(strip);
 }
 
 void draw_tool_icon(ToolMode mode) {
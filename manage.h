@@ -3,15 +3,21 @@
 
 #include "Device.h"
 #include "Game.h"
+#include "Mode.h"
 #include "Animation.h"
+#include "Scheduler.h"
+#include "Power.h"
+#include "Profiler.h"
 
 
 void handle_input(KeyEvent event);
-void render_frame(void);
 void handle_input(void);
-void render_frame(void);
+void render_frame(uint8_t sim_steps);
+uint8_t get_target_fps(void);
+#if ENABLE_PROFILER
+ProfileMode profile_mode_of_state(void);
+#endif
 void draw_main_menu_icon(MainMode mode);
-void draw_game_icon(GameMode mode);
 void draw_tool_icon(ToolMode mode);
 void render_battery_overlay(void);
 void draw_brightness_icon(uint8_t level);